@@ -0,0 +1,198 @@
+#pragma once
+
+#include "CmdParser.h"
+#include <array>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+
+namespace mcu {
+
+/*
+Coroutine handlers for CmdParser (C++20).
+
+A long running command can be written as a coroutine instead of a hand-rolled
+state machine that returns CmdParserRetType::not_finished:
+
+CmdTask flash_write(VLItemLifo<128>& args)
+{
+    co_await mcu::until([]{ return flash_ready(); });
+    ...
+    co_await mcu::delay<Tim32_us>(10ms);
+    co_await mcu::until([]{ return serial.txFreeSpace() >= 16; });
+    serial.txFrameAppend(...);
+    co_return CmdParserRetType::finished_ok;
+}
+
+and registered in the commands table through the cmdCoroutine adapter:
+
+constexpr std::array<std::pair<std::string_view,CmdParser...::commandProcessorPrototype>,N> commands
+{{
+    {"flash_write",mcu::cmdCoroutine<128,flash_write>},
+    ...
+}};
+
+The parser calls the adapter as any other handler: the coroutine runs until
+its first co_await, and on the next calls it is resumed only when the
+condition it waits for is true. Many commands can be in flight at the same
+time (see t_queueLen/t_maxConcurrent of CmdParser).
+
+The coroutine frames are not allocated on the heap: they are taken from a
+static pool of t_frames blocks of t_frameSize bytes (CoroutineFramePool).
+If the pool is exhausted (or the frame does not fit in a block) the command
+finishes with CmdParserRetType::finished_nok.
+*/
+
+template<size_t t_frameSize,uint8_t t_frames>
+class CoroutineFramePool
+{
+private:
+    struct Block
+    {
+        alignas(std::max_align_t) std::byte data[t_frameSize];
+    };
+public:
+    static void* allocate(size_t size) noexcept
+    {
+        if( size > t_frameSize )
+            return nullptr;
+        for( uint8_t i=0 ; i<t_frames ; i++ )
+        {
+            if( _used[i] )
+                continue;
+            _used[i] = true;
+            return _blocks[i].data;
+        }
+        return nullptr;
+    }
+    static void release(void* ptr) noexcept
+    {
+        for( uint8_t i=0 ; i<t_frames ; i++ )
+            if( ptr == _blocks[i].data )
+                _used[i] = false;
+    }
+private:
+    static inline std::array<Block,t_frames> _blocks;
+    static inline std::array<bool,t_frames>  _used{};
+};
+
+template<typename t_Pool = CoroutineFramePool<256,4>>
+class CmdTaskT
+{
+public:
+    struct promise_type
+    {
+        CmdParserRetType result = CmdParserRetType::finished_nok;
+        //condition the coroutine is waiting for (nullptr: not waiting)
+        bool (*readyFn)(void*) = nullptr;
+        void* waiter = nullptr;
+
+        CmdTaskT get_return_object() { return CmdTaskT(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        static CmdTaskT get_return_object_on_allocation_failure() { return CmdTaskT(); }
+        std::suspend_never  initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend()   noexcept { return {}; }
+        void return_value(CmdParserRetType ret) { result = ret; }
+        void unhandled_exception() { std::terminate(); }
+        static void* operator new(size_t size) noexcept { return t_Pool::allocate(size); }
+        static void  operator delete(void* ptr) noexcept { t_Pool::release(ptr); }
+        bool ready() const { return readyFn == nullptr || readyFn(waiter); }
+    };
+public:
+    CmdTaskT() = default;
+    CmdTaskT(const CmdTaskT&) = delete;
+    CmdTaskT(CmdTaskT&& other) noexcept : _handle(other._handle) { other._handle = nullptr; }
+    CmdTaskT& operator=(const CmdTaskT&) = delete;
+    CmdTaskT& operator=(CmdTaskT&& other) noexcept
+    {
+        if( this != &other )
+        {
+            destroy();
+            _handle = other._handle;
+            other._handle = nullptr;
+        }
+        return *this;
+    }
+    ~CmdTaskT() { destroy(); }
+    bool valid() const { return bool(_handle); }
+    //resumes the coroutine if what it waits for is ready
+    CmdParserRetType poll()
+    {
+        if( !_handle )
+            return CmdParserRetType::finished_nok;
+        if( !_handle.done() )
+        {
+            auto& promise = _handle.promise();
+            if( !promise.ready() )
+                return CmdParserRetType::not_finished;
+            promise.readyFn = nullptr;
+            _handle.resume();
+        }
+        if( !_handle.done() )
+            return CmdParserRetType::not_finished;
+        return _handle.promise().result;
+    }
+private:
+    explicit CmdTaskT(std::coroutine_handle<promise_type> handle) : _handle(handle) {}
+    void destroy()
+    {
+        if( _handle )
+            _handle.destroy();
+        _handle = nullptr;
+    }
+private:
+    std::coroutine_handle<promise_type> _handle = nullptr;
+};
+
+using CmdTask = CmdTaskT<>;
+
+//awaitable: suspends the coroutine until f() returns true
+template<typename F>
+class WaitUntil
+{
+public:
+    WaitUntil(F f) : _f(f) {}
+    bool await_ready() { return _f(); }
+    template<typename t_Promise>
+    void await_suspend(std::coroutine_handle<t_Promise> handle)
+    {
+        handle.promise().waiter  = this;
+        handle.promise().readyFn = [](void* self) -> bool { return static_cast<WaitUntil*>(self)->_f(); };
+    }
+    void await_resume() {}
+private:
+    F _f;
+};
+
+template<typename F>
+auto until(F f) { return WaitUntil<F>(f); }
+
+//awaitable: suspends the coroutine for dt (measured with an mcu::Timer)
+template<typename t_Timer,typename t_Rep,typename t_Period>
+auto delay(std::chrono::duration<t_Rep,t_Period> dt)
+{
+    return until([deadline = typename t_Timer::Deadline(dt)]{ return deadline.expired(); });
+}
+
+/*
+Adapts a coroutine handler to the CmdParser handler prototype. A handler is
+never running twice at the same time (see CmdParser), so one task per
+coroutine is enough.
+*/
+template<size_t t_frameMaxLen,auto t_coroutine>
+CmdParserRetType cmdCoroutine(VLItemLifo<t_frameMaxLen>& args)
+{
+    static decltype(t_coroutine(args)) task;
+    if( !task.valid() )
+    {
+        task = t_coroutine(args);
+        if( !task.valid() )
+            return CmdParserRetType::finished_nok;
+    }
+    auto ret = task.poll();
+    if( ret != CmdParserRetType::not_finished )
+        task = {};
+    return ret;
+}
+
+} //namespace mcu
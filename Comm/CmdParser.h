@@ -90,11 +90,57 @@ enum class CmdParserRetType: uint8_t
     not_finished
 };
 
+enum class CmdParserMode: uint8_t
+{
+    text,
+    binary
+};
+
+/*
+Pipelining:
+t_queueLen parsed commands can be waiting/running at the same time. While a
+handler returns CmdParserRetType::not_finished the parser keeps scanning and
+parsing the next frames into the free slots of the queue, so the input buffer
+does not overflow while a slow handler (flash, sensors, etc) runs.
+t_maxConcurrent is the amount of queued commands whose handlers are invoked
+on each call (in arrival order). With t_maxConcurrent == 1 the commands are
+executed one after the other (the same order they arrived). A handler is
+never running twice at the same time (a second instance waits until the
+first one finishes), so handlers can keep their state in static variables.
+The defaults (1,1) give the original behaviour: no parsing while a handler
+is running.
+
+Binary mode (t_mode == CmdParserMode::binary):
+For machine to machine links, frames are length-prefixed instead of being
+text terminated by t_eofMarker (t_separator and t_eofMarker are not used):
+
+[frame len][command id][field len][field]...[field len][field]
+
+All the lengths and the command id are varints (LEB128: 7 bits per byte, lsb
+first, msb set on all bytes but the last one). The frame len counts the bytes
+after itself. The command id is the index of the command in
+t_commandProcessors (see commandId()). The fields are copied as they are
+(no tokenizing, no quotes, raw binary values) from the input buffer to the
+VLItemLifo of the command, where item 0 is the command name as in text mode,
+so the same handlers serve both modes.
+
+Example, command 2 with the fields {0x10,0x00} and "ab":
+0x07 0x02 0x02 0x10 0x00 0x02 'a' 'b'
+
+There is no resynchronization marker in binary mode, so the link must not lose
+bytes (a framed and checked link, like mcu::Serial with a Crc, or
+mcu::StreamSocket). Frames longer than the input buffer are skipped and the
+bytes pushed while the input buffer is full are dropped, use rxFreeSpace()
+to apply backpressure.
+*/
 template<   char   t_separator     , // = ' '
             char   t_eofMarker     , // = '\r
             size_t t_frameMaxLen   , // = 128
             size_t t_commandsCount ,
-            const std::array<std::pair<std::string_view,CmdParserRetType(*)(VLItemLifo<t_frameMaxLen>&)>,t_commandsCount>& t_commandProcessors>
+            const std::array<std::pair<std::string_view,CmdParserRetType(*)(VLItemLifo<t_frameMaxLen>&)>,t_commandsCount>& t_commandProcessors,
+            uint8_t t_queueLen      = 1,
+            uint8_t t_maxConcurrent = 1,
+            CmdParserMode t_mode    = CmdParserMode::text>
 class CmdParser
 {
 private:
@@ -111,6 +157,8 @@ private:
         return true;
     }
     static_assert( check_all_different<t_commandProcessors>() , "command tag repeated" );
+    static_assert( t_queueLen > 0 , "t_queueLen must be greater than zero" );
+    static_assert( t_maxConcurrent > 0 && t_maxConcurrent <= t_queueLen , "t_maxConcurrent must be in the range [1,t_queueLen]" );
 private:
     using BufferType = FifoBuffer<uint8_t,t_frameMaxLen>;
     enum class TaskState
@@ -118,11 +166,16 @@ private:
         shutdown,
         readUntilEof,
         parseFrame,
-        identifyCommand,
-        invokeCommand
+        identifyCommand
     };
 public:
     using commandProcessorPrototype = CmdParserRetType(*)(VLItemLifo<t_frameMaxLen>&);
+private:
+    struct Slot
+    {
+        VLItemLifo<t_frameMaxLen> command;
+        commandProcessorPrototype processor;
+    };
 public:
     void start()
     {
@@ -133,17 +186,44 @@ public:
             _pushCnt = 0;
             _pushWaitEof = false;
             _rxBuff.clear();
+            _queued = 0;
+            _skip = 0;
         }
     }
+    //id of a command in binary mode (-1 if the command does not exist)
+    static constexpr int commandId(std::string_view name)
+    {
+        for( size_t i=0 ; i<t_commandsCount ; i++ )
+            if( t_commandProcessors[i].first == name )
+                return int(i);
+        return -1;
+    }
     void operator()()
     {
         if( _st == TaskState::shutdown )
             return;
+        parse();
+        invoke();
+    }
+private:
+    //scans/parses the next frame into a free slot of the queue
+    void parse()
+    {
+        //no free slot: the frames wait in _rxBuff
+        if( _queued == t_queueLen )
+            return;
+        auto& cmd = _slots[_order[_queued]].command;
+        auto& processor = _slots[_order[_queued]].processor;
+        if constexpr ( t_mode == CmdParserMode::binary )
+        {
+            parseBinary(cmd,processor);
+            return;
+        }
         if( _st == TaskState::readUntilEof )
         {
             if( _eofIdx >= _rxBuff.length() )
                 return;
-            auto cnt = std::min(_rxBuff.length()-_eofIdx,1);
+            auto cnt = std::min<size_t>(_rxBuff.length()-_eofIdx,1);
             while( cnt-- )
             {
                 if( _rxBuff[_eofIdx] == t_eofMarker )
@@ -164,7 +244,7 @@ public:
                 return;
             }
 //            std::cout << " --> frame parsing" << std::endl;
-            _command.clear();
+            cmd.clear();
             //string   _______________-----------------_____________
             //capture  ___-----_-----_------------------_-----------
             //com value:  write value "this is a string" other_value
@@ -183,7 +263,7 @@ public:
             bool parsingOk = true;
             for( typename BufferType::IdxType i=0 ; i<_eofIdx ; i++ )
             {
-                if( _command.freeSpace() == 0 )
+                if( cmd.freeSpace() == 0 )
                 {
                     parsingOk = false;
                     break;
@@ -204,9 +284,9 @@ public:
                 {
                     auto data = _rxBuff[i];
                     if( prevCapture == false )
-                        _command.pushItem(data);
+                        cmd.pushItem(data);
                     else
-                        _command.appendByteToItem(data);
+                        cmd.appendByteToItem(data);
                 }
                 prevCapture = capture;
             }
@@ -219,7 +299,7 @@ public:
             _rxBuff.remove(1);
             _eofIdx = 0;
 //            std::cout << "**** _command in parsing ****" << std::endl;
-//            _command.template print_internals<char,false>();
+//            cmd.template print_internals<char,false>();
             if( !parsingOk )
             {
 //                std::cout << "{command overflow}" << std::endl;
@@ -232,7 +312,7 @@ public:
         }
         if( _st == TaskState::identifyCommand )
         {
-            if( auto command = _command.peekStringAt(0); command.has_value() )
+            if( auto command = cmd.peekStringAt(0); command.has_value() )
             {
                 const auto findCommandProcessor = [&](std::string_view strv)->commandProcessorPrototype
                 {
@@ -246,10 +326,9 @@ public:
                         return nullptr;
                     return found->second;
                 };
-                using VLIdx = typename decltype(_command)::IdxType;
                 auto strv = command.value();
 //                std::cout << "command: " << strv << std::endl;
-                _processor = findCommandProcessor(strv);
+                processor = findCommandProcessor(strv);
 /*                for( auto item : t_commandProcessors )
                 {
                     if( strlen(item.first) != strv.size() )
@@ -263,30 +342,168 @@ public:
                     }
                     if( comFound )
                     {
-                        _processor = item.second;
+                        processor = item.second;
                         break;
                     }
                 }*/
-                if( _processor == nullptr )
+                if( processor == nullptr )
                 {
                     _st = TaskState::readUntilEof;
                     return;
                 }
             }
-            _st = TaskState::invokeCommand;
+            else
+                processor = nullptr;
+            //the command is queued, its handler is invoked by invoke()
+            if( processor != nullptr )
+                _queued++;
+            _st = TaskState::readUntilEof;
             return;
         }
-        if( _st == TaskState::invokeCommand )
+    }
+    //binary mode: waits for a whole frame and decodes it into the slot
+    void parseBinary(VLItemLifo<t_frameMaxLen>& cmd,commandProcessorPrototype& processor)
+    {
+        using IdxType = typename BufferType::IdxType;
+        if( _st == TaskState::readUntilEof )
         {
-//            _command.template print_internals<char,false>();
-            if( _processor(_command) == CmdParserRetType::not_finished )
+            if( _skip != 0 )
+            {
+                IdxType cnt = IdxType(std::min<uint32_t>(_skip,_rxBuff.length()));
+                _rxBuff.remove(cnt);
+                _skip -= cnt;
                 return;
-            _st = TaskState::readUntilEof;
+            }
+            //_eofIdx: bytes already seen while waiting for the frame
+            if( _eofIdx == _rxBuff.length() )
+                return;
+            IdxType idx = 0;
+            uint32_t len = 0;
+            if( !peekVarint(idx,len) )
+            {
+                _eofIdx = _rxBuff.length();
+                //a length that does not fit in the whole buffer is garbage
+                if( _rxBuff.isFull() )
+                {
+                    _rxBuff.clear();
+                    _eofIdx = 0;
+                }
+                return;
+            }
+            //the frame will never fit in the input buffer
+            if( len > BufferType::maxLen-1-idx )
+            {
+                _skip = len > UINT32_MAX-idx ? UINT32_MAX : len+idx;
+                _eofIdx = 0;
+                return;
+            }
+            if( _rxBuff.length() < idx+len )
+            {
+                _eofIdx = _rxBuff.length();
+                return;
+            }
+            _eofIdx = IdxType(idx+len);
+            _st = TaskState::parseFrame;
             return;
         }
+        if( _st == TaskState::parseFrame )
+        {
+            cmd.clear();
+            IdxType idx = 0;
+            uint32_t aux = 0;
+            uint32_t id = 0;
+            peekVarint(idx,aux);
+            bool parsingOk = peekVarint(idx,id) && idx <= _eofIdx && id < t_commandsCount && cmd.pushEmptyItem();
+            if( parsingOk )
+                for( auto data : t_commandProcessors[id].first )
+                    parsingOk &= cmd.appendByteToItem(uint8_t(data));
+            while( parsingOk && idx < _eofIdx )
+            {
+                uint32_t len = 0;
+                parsingOk = peekVarint(idx,len) && idx <= _eofIdx && len <= uint32_t(_eofIdx-idx) && cmd.pushEmptyItem();
+                for( ; parsingOk && len != 0 ; len-- )
+                    parsingOk = cmd.appendByteToItem(_rxBuff[idx++]);
+            }
+            _rxBuff.remove(_eofIdx);
+            _eofIdx = 0;
+            _st = TaskState::readUntilEof;
+            if( !parsingOk )
+                return;
+            processor = t_commandProcessors[id].second;
+            _queued++;
+        }
+    }
+    //decodes the varint at _rxBuff[idx] (false if it is not complete yet)
+    bool peekVarint(typename BufferType::IdxType& idx,uint32_t& value)
+    {
+        value = 0;
+        for( uint8_t shift=0 ; idx<_rxBuff.length() ; shift+=7 )
+        {
+            uint8_t data = _rxBuff[idx++];
+            //more than 32 bits: the value saturates (the frame is skipped)
+            value |= shift < 32 ? uint32_t(data & 0x7F) << shift : 0;
+            if( shift >= 32 && (data & 0x7F) )
+                value = UINT32_MAX;
+            if( (data & 0x80) == 0 )
+                return true;
+        }
+        return false;
+    }
+    //invokes the handlers of the first t_maxConcurrent queued commands
+    void invoke()
+    {
+        uint8_t idx = 0;
+        uint8_t running = 0;
+        while( idx < _queued && running < t_maxConcurrent )
+        {
+            auto& slot = _slots[_order[idx]];
+            //the same handler can not run twice at the same time (a waiting
+            //duplicate does not take one of the t_maxConcurrent places)
+            bool busy = false;
+            for( uint8_t j=0 ; j<idx ; j++ )
+                busy |= _slots[_order[j]].processor == slot.processor;
+            if( busy )
+            {
+                idx++;
+                continue;
+            }
+            running++;
+            if( slot.processor(slot.command) == CmdParserRetType::not_finished )
+            {
+                idx++;
+                continue;
+            }
+            //finished: free the slot (it goes to the end of the order)
+            uint8_t freed = _order[idx];
+            for( uint8_t j=idx ; j+1<t_queueLen ; j++ )
+                _order[j] = _order[j+1];
+            _order[t_queueLen-1] = freed;
+            _queued--;
+        }
     }
+public:
+    //amount of parsed commands waiting or running
+    uint8_t pendingCommands() const { return _queued; }
+    //false if operator() has nothing to do until more data is pushed
+    bool hasWork() const
+    {
+        if( _st == TaskState::shutdown )
+            return false;
+        if( _queued != 0 || _st != TaskState::readUntilEof )
+            return true;
+        if( _skip != 0 )
+            return !_rxBuff.isEmpty();
+        return _eofIdx < _rxBuff.length();
+    }
+    //bytes that can be pushed before the input buffer overflows
+    size_t rxFreeSpace() const { return _rxBuff.freeSpace(); }
     void pushData(uint8_t data)
     {
+        if constexpr ( t_mode == CmdParserMode::binary )
+        {
+            _rxBuff.put(data);
+            return;
+        }
         if( _rxBuff.isFull() )
         {
 //            std::cout << "[overflow detected]" << std::endl;
@@ -315,13 +532,25 @@ public:
     }
 private:
     bool isSeparator(uint8_t data) const{ return (data==t_separator) || (t_separator==' ' && data=='\t'); }
+    static constexpr std::array<uint8_t,t_queueLen> makeOrder()
+    {
+        std::array<uint8_t,t_queueLen> order{};
+        for( uint8_t i=0 ; i<t_queueLen ; i++ )
+            order[i] = i;
+        return order;
+    }
 private:
     BufferType _rxBuff;
-    VLItemLifo<t_frameMaxLen> _command;
-    commandProcessorPrototype _processor;
+    std::array<Slot,t_queueLen> _slots;
+    //_order[0.._queued) are the queued commands (in arrival order),
+    //_order[_queued] is the slot where the next frame is parsed
+    std::array<uint8_t,t_queueLen> _order = makeOrder();
+    uint8_t _queued = 0;
     typename BufferType::IdxType _eofIdx;
     TaskState _st = TaskState::shutdown;
     typename BufferType::IdxType _pushCnt = 0;
     bool _pushWaitEof = false;
+    //binary mode: bytes of a too long frame still to be skipped
+    uint32_t _skip = 0;
 };
 } //namespace mcu
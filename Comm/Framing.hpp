@@ -0,0 +1,374 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace mcu
+{
+
+/**
+ * Framing policies for mcu::Serial (template parameter t_Framing).
+ *
+ * TimeoutFraming: a frame ends when the bus is quiet for at least
+ *                 t_eofTimeoutUs (default, the original behaviour).
+ *
+ * SlipFraming / CobsFraming: frames are byte-stuffed and terminated by a
+ *                 delimiter, so frames can be sent back to back without
+ *                 idle time and survive links that coalesce bytes
+ *                 (usb-cdc, tcp bridges, etc).
+ *
+ * A delimited policy provides:
+ *  Decoder: fed one input byte at a time, returns FramingResult::data
+ *           (and the decoded byte) at most once per input byte, so the
+ *           decoding is O(n) and needs no extra buffer.
+ *  Encoder: start(len) then next(src) returns the encoded bytes one at a
+ *           time until done(). src(idx) must return the idx-th payload
+ *           byte, so the encoder works in place on the tx buffer.
+ *  LinearEncoder: streaming encoder that writes into a linear buffer
+ *           (begin(), put() as many times as needed, end()), used by
+ *           mcu::SerialTranseiver. Each method returns false if the
+ *           buffer has no room left (len is the used length of out).
+ * Empty frames are ignored by the decoders.
+ */
+enum class FramingResult : uint8_t
+{
+    none,
+    data,
+    eof,
+    error
+};
+
+struct TimeoutFraming
+{
+    static constexpr bool delimited = false;
+    //no byte stuffing
+    struct Decoder {};
+    struct Encoder {};
+    struct LinearEncoder {};
+};
+
+/**
+ * SLIP (RFC 1055), a frame is sent as:
+ *  END data... END
+ * where END bytes in data are sent as ESC ESC_END and ESC bytes as ESC ESC_ESC.
+ * Worst case overhead: 2*len+2 bytes.
+ */
+struct SlipFraming
+{
+    static constexpr bool delimited = true;
+    static constexpr uint8_t END     = 0xC0;
+    static constexpr uint8_t ESC     = 0xDB;
+    static constexpr uint8_t ESC_END = 0xDC;
+    static constexpr uint8_t ESC_ESC = 0xDD;
+
+    class Decoder
+    {
+    public:
+        auto reset() -> void { _esc = false; _discard = false; }
+        //ignore everything until the next END
+        auto discard() -> void { _discard = true; }
+        auto feed(uint8_t in,uint8_t& out) -> FramingResult
+        {
+            if( in == END )
+            {
+                bool discarded = _discard;
+                reset();
+                return discarded ? FramingResult::none : FramingResult::eof;
+            }
+            if( _discard )
+                return FramingResult::none;
+            if( _esc )
+            {
+                _esc = false;
+                if( in == ESC_END )
+                    out = END;
+                else if( in == ESC_ESC )
+                    out = ESC;
+                else
+                {
+                    _discard = true;
+                    return FramingResult::error;
+                }
+                return FramingResult::data;
+            }
+            if( in == ESC )
+            {
+                _esc = true;
+                return FramingResult::none;
+            }
+            out = in;
+            return FramingResult::data;
+        }
+    private:
+        bool _esc     = false;
+        bool _discard = false;
+    };
+
+    class Encoder
+    {
+    private:
+        enum class State : uint8_t
+        {
+            start,
+            data,
+            escaped,
+            end,
+            done
+        };
+    public:
+        auto start(size_t len) -> void
+        {
+            _len = len;
+            _idx = 0;
+            _st  = State::start;
+        }
+        auto done() const -> bool { return _st == State::done; }
+        template<typename t_Src>
+        auto next(const t_Src& src) -> uint8_t
+        {
+            if( _st == State::start )
+            {
+                //leading END flushes any line noise at the receiver
+                _st = _len != 0 ? State::data : State::end;
+                return END;
+            }
+            if( _st == State::data )
+            {
+                uint8_t data = src(_idx);
+                if( data == END || data == ESC )
+                {
+                    _escaped = data == END ? ESC_END : ESC_ESC;
+                    _st = State::escaped;
+                    return ESC;
+                }
+                if( ++_idx == _len )
+                    _st = State::end;
+                return data;
+            }
+            if( _st == State::escaped )
+            {
+                _st = ++_idx == _len ? State::end : State::data;
+                return _escaped;
+            }
+            _st = State::done;
+            return END;
+        }
+    private:
+        size_t  _len = 0;
+        size_t  _idx = 0;
+        uint8_t _escaped = 0;
+        State   _st = State::done;
+    };
+
+    class LinearEncoder
+    {
+    public:
+        auto begin(uint8_t* out,size_t cap,size_t& len) -> bool
+        {
+            if( len >= cap )
+                return false;
+            out[len++] = END;
+            return true;
+        }
+        auto put(uint8_t* out,size_t cap,size_t& len,const uint8_t* data,size_t n) -> bool
+        {
+            for( size_t idx=0 ; idx<n ; idx++ )
+            {
+                uint8_t in = data[idx];
+                if( in == END || in == ESC )
+                {
+                    if( len+2 > cap )
+                        return false;
+                    out[len++] = ESC;
+                    out[len++] = in == END ? ESC_END : ESC_ESC;
+                    continue;
+                }
+                if( len >= cap )
+                    return false;
+                out[len++] = in;
+            }
+            return true;
+        }
+        auto end(uint8_t* out,size_t cap,size_t& len) -> bool
+        {
+            return begin(out,cap,len);
+        }
+    };
+};
+
+/**
+ * COBS (Consistent Overhead Byte Stuffing), the frame is encoded in blocks
+ * of up to 254 non-zero bytes prefixed by a code byte and terminated by 0x00.
+ * Worst case overhead: len/254+2 bytes.
+ */
+struct CobsFraming
+{
+    static constexpr bool delimited = true;
+    static constexpr uint8_t DELIMITER = 0x00;
+
+    class Decoder
+    {
+    public:
+        auto reset() -> void
+        {
+            _cnt = 0;
+            _pendingZero = false;
+            _discard = false;
+        }
+        //ignore everything until the next delimiter
+        auto discard() -> void { _discard = true; }
+        auto feed(uint8_t in,uint8_t& out) -> FramingResult
+        {
+            if( in == DELIMITER )
+            {
+                bool truncated = _cnt != 0;
+                bool discarded = _discard;
+                reset();
+                if( discarded )
+                    return FramingResult::none;
+                return truncated ? FramingResult::error : FramingResult::eof;
+            }
+            if( _discard )
+                return FramingResult::none;
+            if( _cnt != 0 )
+            {
+                _cnt--;
+                out = in;
+                return FramingResult::data;
+            }
+            //code byte: the zero implied by the previous block is only
+            //emitted now that we know another block follows
+            bool zero = _pendingZero;
+            _cnt = in - 1;
+            _pendingZero = in != 0xFF;
+            if( !zero )
+                return FramingResult::none;
+            out = 0;
+            return FramingResult::data;
+        }
+    private:
+        uint8_t _cnt = 0;
+        bool    _pendingZero = false;
+        bool    _discard = false;
+    };
+
+    class Encoder
+    {
+    private:
+        enum class State : uint8_t
+        {
+            code,
+            data,
+            delimiter,
+            done
+        };
+    public:
+        auto start(size_t len) -> void
+        {
+            _len = len;
+            _idx = 0;
+            _st  = State::code;
+        }
+        auto done() const -> bool { return _st == State::done; }
+        template<typename t_Src>
+        auto next(const t_Src& src) -> uint8_t
+        {
+            if( _st == State::code )
+            {
+                //look ahead for the next zero (at most 254 bytes), every
+                //payload byte is scanned once here and read once in State::data
+                uint8_t n = 0;
+                while( _idx+n < _len && n < 254 && src(_idx+n) != 0 )
+                    n++;
+                _blockLeft = n;
+                _zeroEnds  = _idx+n < _len && n < 254;
+                if( n == 0 )
+                    endBlock();
+                else
+                    _st = State::data;
+                return n + 1;
+            }
+            if( _st == State::data )
+            {
+                uint8_t data = src(_idx++);
+                if( --_blockLeft == 0 )
+                    endBlock();
+                return data;
+            }
+            _st = State::done;
+            return DELIMITER;
+        }
+    private:
+        auto endBlock() -> void
+        {
+            //skip the zero that ended the block (it is implied by the code),
+            //a block ended by a zero is always followed by another block
+            if( _zeroEnds )
+                _idx++;
+            _st = (_zeroEnds || _idx < _len) ? State::code : State::delimiter;
+        }
+    private:
+        size_t  _len = 0;
+        size_t  _idx = 0;
+        uint8_t _blockLeft = 0;
+        bool    _zeroEnds  = false;
+        State   _st = State::done;
+    };
+
+    //the code byte of the current block is reserved when the block starts
+    //and patched when it ends, so no look ahead is needed
+    class LinearEncoder
+    {
+    public:
+        auto begin(uint8_t* out,size_t cap,size_t& len) -> bool
+        {
+            return openBlock(out,cap,len);
+        }
+        auto put(uint8_t* out,size_t cap,size_t& len,const uint8_t* data,size_t n) -> bool
+        {
+            for( size_t idx=0 ; idx<n ; idx++ )
+            {
+                if( data[idx] == 0 )
+                {
+                    out[_codeIdx] = _code;
+                    if( !openBlock(out,cap,len) )
+                        return false;
+                    continue;
+                }
+                if( len >= cap )
+                    return false;
+                out[len++] = data[idx];
+                if( ++_code == 0xFF )
+                {
+                    out[_codeIdx] = _code;
+                    if( !openBlock(out,cap,len) )
+                        return false;
+                }
+            }
+            return true;
+        }
+        auto end(uint8_t* out,size_t cap,size_t& len) -> bool
+        {
+            if( len >= cap )
+                return false;
+            out[_codeIdx] = _code;
+            out[len++] = DELIMITER;
+            return true;
+        }
+    private:
+        auto openBlock(uint8_t* out,size_t cap,size_t& len) -> bool
+        {
+            if( len >= cap )
+                return false;
+            _codeIdx = len;
+            out[len++] = 0xFF;
+            _code = 1;
+            return true;
+        }
+    private:
+        size_t  _codeIdx = 0;
+        uint8_t _code = 1;
+    };
+};
+
+}//namespace mcu
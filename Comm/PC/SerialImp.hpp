@@ -0,0 +1,327 @@
+#pragma once
+
+/**
+ * Host (linux) stand-ins for the uart hooks of mcu::Serial and
+ * mcu::SerialTranseiver, so both can be run and measured on a pc.
+ *
+ * The hooks are plain function pointers, so every port is a class with
+ * static members identified by t_id (one id per simulated uart). The hooks
+ * are templates on the return type, so they match the exact function
+ * pointer type expected by each class (uint8_t/uint16_t/uint32_t).
+ *
+ * LoopbackPort<t_id,t_baud,t_peer>:
+ *  In-memory uart. The bytes written by port t_id are received by the port
+ *  whose t_peer is t_id (by default a port is connected to itself). The
+ *  baud rate is simulated: each byte takes 10 bits (8N1) on the wire, a new
+ *  byte is accepted only when the previous one left the tx register and it
+ *  becomes available at the receiver once it fully arrived.
+ *  setLossPpm() makes the wire lossy: each byte is dropped with the given
+ *  probability (parts per million), to simulate noisy or radio links.
+ *
+ * FdPort<t_id>:
+ *  Uart backed by a file descriptor: a pty master (openPty(), the slave
+ *  path can be opened by any other program or by another FdPort with
+ *  open()), a real tty or one end of a socketpair (connectSocketPair()).
+ *
+ * Example:
+ *  using Uart = LoopbackPort<0,115200>;
+ *  mcu::Serial<256,256,Tim64_us,1000,
+ *              Uart::rxAvailable,Uart::rxRead,Uart::txReady,Uart::txWrite> serial;
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <utility>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace mcu
+{
+
+template<int t_id>
+struct LoopbackWire
+{
+    using Clock = std::chrono::steady_clock;
+    //bytes on the wire and the moment each one fully arrives
+    static inline std::deque<std::pair<Clock::time_point,uint8_t>> bytes;
+    static inline Clock::time_point txFreeAt{};
+    static inline uint32_t lossPpm = 0;
+    static inline uint32_t seed = 0x12345678u + uint32_t(t_id);
+    //xorshift32, cheap and deterministic
+    static bool lost()
+    {
+        if( lossPpm == 0 )
+            return false;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed % 1000000u < lossPpm;
+    }
+};
+
+template<int t_id,uint32_t t_baud,int t_peer = t_id>
+class LoopbackPort
+{
+private:
+    static_assert(t_baud > 0,"t_baud must be greater than zero");
+    using Clock = std::chrono::steady_clock;
+    using TxWire = LoopbackWire<t_id>;
+    using RxWire = LoopbackWire<t_peer>;
+public:
+    //10 bits per byte: start + 8 data + stop
+    static constexpr auto byteTime = std::chrono::nanoseconds(10'000'000'000ull/t_baud);
+public:
+    template<typename T = uint32_t>
+    static T rxAvailable()
+    {
+        //arrival times are monotonic
+        auto now = Clock::now();
+        auto arrived = std::partition_point(RxWire::bytes.begin(),RxWire::bytes.end(),
+                                            [&](const auto& item){ return item.first <= now; });
+        size_t count = size_t(arrived - RxWire::bytes.begin());
+        return T(std::min<size_t>(count,std::numeric_limits<T>::max()));
+    }
+    static uint8_t rxRead()
+    {
+        if( RxWire::bytes.empty() )
+            return 0;
+        uint8_t data = RxWire::bytes.front().second;
+        RxWire::bytes.pop_front();
+        return data;
+    }
+    static bool txReady()
+    {
+        return Clock::now() >= TxWire::txFreeAt;
+    }
+    static void txWrite(uint8_t data)
+    {
+        auto start = std::max(Clock::now(),TxWire::txFreeAt);
+        TxWire::txFreeAt = start + byteTime;
+        if( !TxWire::lost() )
+            TxWire::bytes.emplace_back(TxWire::txFreeAt,data);
+    }
+    static void txWrite(const uint8_t* buff,uint32_t len)
+    {
+        while( len-- )
+            txWrite(*buff++);
+    }
+    static void setLossPpm(uint32_t ppm)
+    {
+        TxWire::lossPpm = ppm;
+    }
+    //back to an idle and lossless wire
+    static void clear()
+    {
+        TxWire::bytes.clear();
+        TxWire::txFreeAt = {};
+        TxWire::lossPpm = 0;
+    }
+};
+
+template<int t_id>
+class FdPort
+{
+private:
+    static constexpr size_t rxChunk = 256;
+public:
+    //creates a pty pair, the port uses the master side
+    static bool openPty()
+    {
+        close();
+        int fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if( fd < 0 )
+            return false;
+        if( grantpt(fd) != 0 || unlockpt(fd) != 0 )
+        {
+            ::close(fd);
+            return false;
+        }
+        //raw mode, otherwise the line discipline would translate bytes
+        termios tio;
+        if( tcgetattr(fd,&tio) == 0 )
+        {
+            cfmakeraw(&tio);
+            tcsetattr(fd,TCSANOW,&tio);
+        }
+        return attach(fd);
+    }
+    //opens a tty device (for instance the slave of another FdPort)
+    static bool open(const char* path)
+    {
+        close();
+        int fd = ::open(path,O_RDWR | O_NOCTTY);
+        if( fd < 0 )
+            return false;
+        termios tio;
+        if( tcgetattr(fd,&tio) == 0 )
+        {
+            cfmakeraw(&tio);
+            tcsetattr(fd,TCSANOW,&tio);
+        }
+        return attach(fd);
+    }
+    //uses an already opened descriptor (the port takes the ownership)
+    static bool attach(int fd)
+    {
+        int flags = fcntl(fd,F_GETFL);
+        if( flags < 0 || fcntl(fd,F_SETFL,flags | O_NONBLOCK) != 0 )
+            return false;
+        struct stat st;
+        _isSocket = fstat(fd,&st) == 0 && S_ISSOCK(st.st_mode);
+        _fd = fd;
+        _rxHead = 0;
+        _rxLen = 0;
+        _txPending = false;
+        _txError = 0;
+        return true;
+    }
+    static void close()
+    {
+        if( _fd >= 0 )
+            ::close(_fd);
+        _fd = -1;
+    }
+    //path of the pty slave (nullptr if the port is not a pty master)
+    static const char* slaveName()
+    {
+        if( _fd < 0 )
+            return nullptr;
+        return ptsname(_fd);
+    }
+    static int fd() { return _fd; }
+public:
+    template<typename T = uint32_t>
+    static T rxAvailable()
+    {
+        if( _rxLen == 0 )
+            fill();
+        int pending = 0;
+        if( _fd >= 0 )
+            ioctl(_fd,FIONREAD,&pending);
+        size_t count = _rxLen + size_t(std::max(pending,0));
+        return T(std::min<size_t>(count,std::numeric_limits<T>::max()));
+    }
+    static uint8_t rxRead()
+    {
+        if( _rxLen == 0 )
+            fill();
+        if( _rxLen == 0 )
+            return 0;
+        uint8_t data = _rxBuff[_rxHead++];
+        _rxLen--;
+        return data;
+    }
+    static bool txReady()
+    {
+        if( _txPending )
+            _txPending = !writeByte(_txData);
+        return !_txPending;
+    }
+    static void txWrite(uint8_t data)
+    {
+        _txData = data;
+        _txPending = !writeByte(data);
+    }
+    //block write (SerialTranseiver), waits until the whole block is accepted
+    //(the hook returns nothing: on an error the rest of the block is dropped,
+    //see txError())
+    static void txWrite(const uint8_t* buff,uint32_t len)
+    {
+        writeAll(buff,len);
+    }
+    //retries on EINTR, waits for room (poll) on EAGAIN, false on any other
+    //error (closed peer, EBADF, EIO...), the errno is kept in txError()
+    static bool writeAll(const uint8_t* buff,uint32_t len)
+    {
+        while( len != 0 )
+        {
+            auto ret = writeFd(buff,len);
+            if( ret > 0 )
+            {
+                buff += ret;
+                len -= uint32_t(ret);
+            }
+            else if( ret < 0 && errno == EINTR )
+                continue;
+            else if( ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) )
+            {
+                pollfd pfd{_fd,POLLOUT,0};
+                if( ::poll(&pfd,1,-1) < 0 && errno != EINTR )
+                {
+                    _txError = errno;
+                    return false;
+                }
+            }
+            else
+            {
+                _txError = ret < 0 ? errno : EPIPE;
+                return false;
+            }
+        }
+        return true;
+    }
+    //errno of the last failed write (0: none since attach())
+    static int txError() { return _txError; }
+private:
+    //false if the byte must be retried (EAGAIN, EINTR), on any other error
+    //it is dropped (see txError()), otherwise txReady() would never be true
+    //again and the Serial tx would hang
+    static bool writeByte(uint8_t data)
+    {
+        auto ret = writeFd(&data,1);
+        if( ret == 1 )
+            return true;
+        if( ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) )
+            return false;
+        _txError = ret < 0 ? errno : EPIPE;
+        return true;
+    }
+    //no SIGPIPE when the peer of a socket is closed, the error is returned
+    static ssize_t writeFd(const uint8_t* buff,size_t len)
+    {
+        if( _isSocket )
+            return ::send(_fd,buff,len,MSG_NOSIGNAL);
+        return ::write(_fd,buff,len);
+    }
+    static void fill()
+    {
+        if( _fd < 0 )
+            return;
+        auto ret = ::read(_fd,_rxBuff.data(),_rxBuff.size());
+        _rxHead = 0;
+        _rxLen = ret > 0 ? size_t(ret) : 0;
+    }
+private:
+    static inline int _fd = -1;
+    static inline std::array<uint8_t,rxChunk> _rxBuff;
+    static inline size_t _rxHead = 0;
+    static inline size_t _rxLen  = 0;
+    static inline uint8_t _txData = 0;
+    static inline bool _txPending = false;
+    static inline bool _isSocket = false;
+    static inline int _txError = 0;
+};
+
+//connects two FdPort through a unix socketpair
+template<int t_idA,int t_idB>
+inline bool connectSocketPair()
+{
+    int fds[2];
+    if( socketpair(AF_UNIX,SOCK_STREAM,0,fds) != 0 )
+        return false;
+    return FdPort<t_idA>::attach(fds[0]) && FdPort<t_idB>::attach(fds[1]);
+}
+
+}//namespace mcu
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CmdParser.h"
+#include "../Timer/Profiler.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace mcu
+{
+
+/** @brief CmdParser handler that dumps the mcu::ProfileProbe statistics
+ *
+ * Prints one line per probe of ProfileProbe<t_Timer,t_bins>:
+ *  name count min max mean h0,h1,...,hN
+ * (ticks, with a "# ticks num/den" header line). "dump reset" clears the
+ * statistics after printing them. t_write must return false if the line
+ * does not fit in the output (tx buffer full): the handler returns
+ * not_finished and retries on the next call.
+ *
+ * Example:
+ *  constexpr std::array<std::pair<std::string_view,CmdParserRetType(*)(VLItemLifo<64>&)>,1>
+ *      commands{{{"dump",mcu::profilerDump<CycleTimer,64,writeLine>}}};
+ */
+template<typename t_Timer,
+         size_t t_frameMaxLen,
+         bool(*t_write)(std::string_view),
+         uint8_t t_bins = 16>
+CmdParserRetType profilerDump(VLItemLifo<t_frameMaxLen>& args)
+{
+    using Probe = ProfileProbe<t_Timer,t_bins>;
+    static bool header = true;
+    static Probe* probe = nullptr;
+    std::array<char,64+12*t_bins> line;
+    size_t len = 0;
+    const auto append = [&](std::string_view str)
+    {
+        size_t cnt = std::min(str.size(),line.size()-len);
+        std::copy_n(str.data(),cnt,line.data()+len);
+        len += cnt;
+    };
+    const auto appendNumber = [&](uint64_t value)
+    {
+        auto res = std::to_chars(line.data()+len,line.data()+line.size(),value);
+        if( res.ec == std::errc() )
+            len = size_t(res.ptr-line.data());
+    };
+    if( header )
+    {
+        append("# ticks ");
+        appendNumber(uint64_t(t_Timer::Num));
+        append("/");
+        appendNumber(uint64_t(t_Timer::Den));
+        append("\n");
+        if( !t_write(std::string_view(line.data(),len)) )
+            return CmdParserRetType::not_finished;
+        header = false;
+        probe = Probe::first();
+    }
+    for( ; probe != nullptr ; probe = probe->next() )
+    {
+        len = 0;
+        append(probe->name());
+        for( uint64_t value : {uint64_t(probe->count()),uint64_t(probe->min()),uint64_t(probe->max()),uint64_t(probe->mean())} )
+        {
+            append(" ");
+            appendNumber(value);
+        }
+        for( uint8_t bin=0 ; bin<t_bins ; bin++ )
+        {
+            append(bin == 0 ? " " : ",");
+            appendNumber(probe->histogram(bin));
+        }
+        append("\n");
+        if( !t_write(std::string_view(line.data(),len)) )
+            return CmdParserRetType::not_finished;
+    }
+    if( args.peekStringAt(1) == std::optional<std::string_view>("reset") )
+        for( auto p=Probe::first() ; p!=nullptr ; p=p->next() )
+            p->reset();
+    header = true;
+    return CmdParserRetType::finished_ok;
+}
+
+}//namespace mcu
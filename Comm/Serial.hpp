@@ -2,8 +2,11 @@
 
 #include <cstdint>
 #include <algorithm>
+#include <array>
 #include <functional>
+#include <span>
 #include "../Container/FifoBuffer.hpp"
+#include "Framing.hpp"
 
 #define DEBUG_SERIAL_DESKTOP
 #ifdef DEBUG_SERIAL_DESKTOP
@@ -13,6 +16,29 @@
 namespace mcu
 {
 
+/**
+ * Double buffered (ping-pong) transceiver, intended for DMA-like uart drivers
+ * that move whole blocks (t_tx_write sends a block and t_tx_ready returns true
+ * once the previous block completely left the uart).
+ *
+ * TX: frames are written into the fill buffer (tx_send appends to the current
+ *     frame, tx_send_then_eof appends and closes it). tx_task swaps the
+ *     buffers and hands the whole frame to t_tx_write in a single call while
+ *     the next frame is written into the other buffer. One frame per buffer,
+ *     so t_tx_len is the max (encoded) frame length.
+ *     With TimeoutFraming consecutive frames are separated by t_eofTimeout.
+ *     A frame that overflows the fill buffer is dropped as a whole: the next
+ *     tx_send calls return false and send nothing, up to the
+ *     tx_send_then_eof that ends it (which returns false too), so the peer
+ *     never receives its tail as a shorter, valid looking frame.
+ *
+ * RX: bytes are read into the fill buffer until the frame completes (bus
+ *     quiet for t_eofTimeout with TimeoutFraming, or the delimiter with a
+ *     delimited framing, see Framing.hpp), then the buffers are swapped and
+ *     the frame is available as a contiguous block (rx_frame_data()) until
+ *     rx_frame_discard() is called. A frame that completes while the previous
+ *     one was not discarded yet is dropped, as are the frames that overflow.
+ */
 template<size_t t_rx_len,
          size_t t_tx_len,
          typename t_Timer,
@@ -20,7 +46,8 @@ template<size_t t_rx_len,
          uint32_t (*t_rx_available)(),
          uint8_t  (*t_rx_read)(),
          bool     (*t_tx_ready)(),
-         void     (*t_tx_write)(const uint8_t*,uint32_t len)>
+         void     (*t_tx_write)(const uint8_t*,uint32_t len),
+         typename t_Framing = TimeoutFraming>
 class SerialTranseiver
 {
 private:
@@ -30,19 +57,212 @@ private:
     static_assert( t_tx_write       != nullptr , "template parameter t_tx_write can not be nullptr");
 public:
     using rx_idx_t = mcu::fit_value_t<t_rx_len>;
+    using tx_idx_t = mcu::fit_value_t<t_tx_len>;
+    static constexpr auto eofTimeout = typename t_Timer::IncPeriod(t_eofTimeout);
 public:
     //rx driver
-    auto rx_frame_available() -> bool { return false; }
-    auto rx_frame_discard() -> void {}
-    auto rx_frame_peek(rx_idx_t idx = 0) const -> uint8_t {}
-    auto rx_task() -> void{}
+    auto rx_frame_available() const -> bool { return _rxReady; }
+    auto rx_frame_length() const -> rx_idx_t { return _rxReady ? _rxLen[1-_rxFill] : 0; }
+    auto rx_frame_data() const -> std::span<const uint8_t>
+    {
+        return {_rxBuff[1-_rxFill].data(),rx_frame_length()};
+    }
+    auto rx_frame_discard() -> void { _rxReady = false; }
+    auto rx_frame_peek(rx_idx_t idx = 0) const -> uint8_t
+    {
+        if( idx >= rx_frame_length() )
+            return 0;
+        return _rxBuff[1-_rxFill][idx];
+    }
+    auto rx_task() -> void
+    {
+        if constexpr ( t_Framing::delimited )
+        {
+            rxTaskDelimited();
+            return;
+        }
+        if( t_rx_available() != 0 )
+        {
+            while( t_rx_available() != 0 )
+            {
+                uint8_t data = t_rx_read();
+                //wait for the bus to be quiet before the first frame
+                if( !_rxSynced )
+                    continue;
+                if( _rxLen[_rxFill] == t_rx_len )
+                    _rxOverflow = true;
+                else
+                    _rxBuff[_rxFill][_rxLen[_rxFill]++] = data;
+                _rxOpen = true;
+            }
+            _rxTim.start();
+            return;
+        }
+        if( _rxTim < eofTimeout )
+            return;
+        _rxSynced = true;
+        if( _rxOpen )
+            rxFrameComplete();
+    }
     //tx driver
-    auto tx_send_then_eof(const uint8_t* buff,uint32_t len) -> void{}
-    auto tx_send(const uint8_t* buff,uint32_t len) -> void {}
-    auto tx_ready() -> bool { return t_tx_ready(); }
-    auto tx_task() -> void{}
+    auto tx_send_then_eof(const uint8_t* buff,uint32_t len) -> bool
+    {
+        if( _txClosed )
+            return false;
+        //end of a dropped frame, the next one starts clean
+        if( _txDropped )
+        {
+            _txDropped = false;
+            return false;
+        }
+        if( !txPut(buff,len) || !txEnd() )
+        {
+            txDrop();
+            _txDropped = false;
+            return false;
+        }
+        _txClosed = true;
+        return true;
+    }
+    auto tx_send(const uint8_t* buff,uint32_t len) -> bool
+    {
+        if( _txClosed || _txDropped )
+            return false;
+        if( !txPut(buff,len) )
+        {
+            txDrop();
+            return false;
+        }
+        return true;
+    }
+    //true if the fill buffer can accept a new frame
+    auto tx_ready() const -> bool { return !_txClosed; }
+    auto tx_task() -> void
+    {
+        if( _txBusy )
+        {
+            if( !t_tx_ready() )
+                return;
+            //the whole block left the uart, the eof gap starts now
+            _txBusy = false;
+            _txTim.start();
+        }
+        if constexpr ( !t_Framing::delimited )
+        {
+            if( _txTim < eofTimeout )
+                return;
+        }
+        if( !_txClosed || !t_tx_ready() )
+            return;
+        uint8_t drain = _txFill;
+        _txFill = 1 - _txFill;
+        _txLen[_txFill] = 0;
+        _txOpen = false;
+        _txClosed = false;
+        _txBusy = true;
+        t_tx_write(_txBuff[drain].data(),uint32_t(_txLen[drain]));
+    }
+private:
+    auto rxFrameComplete() -> void
+    {
+        if( !_rxOverflow && !_rxReady && _rxLen[_rxFill] != 0 )
+        {
+            _rxFill = 1 - _rxFill;
+            _rxReady = true;
+        }
+        _rxLen[_rxFill] = 0;
+        _rxOverflow = false;
+        _rxOpen = false;
+    }
+    auto rxTaskDelimited() -> void
+    {
+        while( t_rx_available() != 0 )
+        {
+            uint8_t data = 0;
+            auto ret = _rxDecoder.feed(t_rx_read(),data);
+            if( ret == FramingResult::none )
+                continue;
+            if( ret == FramingResult::error )
+            {
+                _rxLen[_rxFill] = 0;
+                _rxOverflow = false;
+                _rxOpen = false;
+                continue;
+            }
+            if( ret == FramingResult::eof )
+            {
+                rxFrameComplete();
+                continue;
+            }
+            _rxOpen = true;
+            if( _rxLen[_rxFill] == t_rx_len )
+                _rxOverflow = true;
+            else
+                _rxBuff[_rxFill][_rxLen[_rxFill]++] = data;
+        }
+    }
+    auto txPut(const uint8_t* buff,uint32_t len) -> bool
+    {
+        auto& out = _txBuff[_txFill];
+        auto& used = _txLen[_txFill];
+        if constexpr ( t_Framing::delimited )
+        {
+            if( !_txOpen )
+            {
+                _txOpen = true;
+                if( !_txEncoder.begin(out.data(),t_tx_len,used) )
+                    return false;
+            }
+            return _txEncoder.put(out.data(),t_tx_len,used,buff,len);
+        }
+        else
+        {
+            _txOpen = true;
+            if( len > t_tx_len - used )
+                return false;
+            std::copy(buff,buff+len,out.data()+used);
+            used += len;
+            return true;
+        }
+    }
+    //the frame does not fit in the fill buffer, drop it (and the rest of it,
+    //until tx_send_then_eof)
+    auto txDrop() -> void
+    {
+        _txLen[_txFill] = 0;
+        _txOpen = false;
+        _txDropped = true;
+    }
+    auto txEnd() -> bool
+    {
+        if constexpr ( t_Framing::delimited )
+        {
+            if( !_txOpen && !txPut(nullptr,0) )
+                return false;
+            return _txEncoder.end(_txBuff[_txFill].data(),t_tx_len,_txLen[_txFill]);
+        }
+        return true;
+    }
 private:
+    std::array<std::array<uint8_t,t_rx_len>,2> _rxBuff;
+    std::array<size_t,2> _rxLen = {0,0};
+    uint8_t _rxFill     = 0;
+    bool    _rxReady    = false;
+    bool    _rxOpen     = false;
+    bool    _rxOverflow = false;
+    bool    _rxSynced   = t_Framing::delimited;
+    t_Timer _rxTim;
+    [[no_unique_address]] typename t_Framing::Decoder _rxDecoder;
 
+    std::array<std::array<uint8_t,t_tx_len>,2> _txBuff;
+    std::array<size_t,2> _txLen = {0,0};
+    uint8_t _txFill   = 0;
+    bool    _txOpen    = false;
+    bool    _txClosed  = false;
+    bool    _txBusy    = false;
+    bool    _txDropped = false;
+    t_Timer _txTim;
+    [[no_unique_address]] typename t_Framing::LinearEncoder _txEncoder;
 };
 /*
 template<
@@ -1,15 +1,35 @@
 #pragma once
 
 #include "../Container/FifoBuffer.hpp"
+#include "Framing.hpp"
 #include "../Timer/Timer.hpp"
+#include "../Utils/Crc.hpp"
 #include "../Utils/TypeUtils.hpp"
 #include "../Utils/SerializableT.hpp"
 
+#include <array>
 #include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <span>
 #include <tuple>
 
 namespace mcu
 {
+/**
+ * TX inter-frame gap handling:
+ *  serial:    after each frame the tx waits a full t_eofTimeoutUs (measured from
+ *             the moment the tx task goes back to init) before looking at the
+ *             next pending frame.
+ *  pipelined: the gap is measured from the moment the last byte of the frame
+ *             left the uart (waitTxComplete) and the next frame is loaded while
+ *             the gap runs, so it is sent as soon as the gap elapses.
+ */
+enum class SerialTxMode : uint8_t
+{
+    serial,
+    pipelined
+};
 /**
  * 1- The frames are terminated by timeout (bus quiet for at least t_eofTimeoutUs microseconds).
  * 2- The length of the frame is only limited by the available space in the RxFifo buffer (t_rxLen).
@@ -18,7 +38,22 @@ namespace mcu
  *    rxFrameLength() returns the length of the first available frame in the RxFifo
  *    rxFramePeekAt(pos) returns the item at position pos of the first frame
  *    rxFrameDiscard() removes the first frame.
- *    
+ * 4- t_txMode selects how the gap between consecutive tx frames is generated
+ *    (see SerialTxMode) and t_txMinGapUs is the minimal gap inserted between
+ *    frames. It defaults to t_eofTimeoutUs and can be lowered when the remote
+ *    end uses a shorter eof timeout.
+ * 5- t_Framing selects how the end of a frame is detected (see Framing.hpp).
+ *    With TimeoutFraming (default) the frames are terminated by timeout as
+ *    described in 1-. With a delimited framing (SlipFraming, CobsFraming) the
+ *    frames are byte-stuffed and terminated by a delimiter, so they are sent
+ *    back to back (t_eofTimeoutUs, t_txMode and t_txMinGapUs only apply to
+ *    the startup of the tx) and are decoded as the bytes arrive.
+ * 6- t_Crc adds a per-frame integrity check (see Utils/Crc.hpp), for instance
+ *    mcu::Crc16Ccitt. The crc is computed while the payload is copied into
+ *    the tx buffer and appended to the frame, and it is computed while the
+ *    bytes enter the rx buffer, so no extra pass over the frame is done.
+ *    Frames with a wrong crc are dropped and the crc bytes are stripped from
+ *    the accepted ones (rxFrameLength() returns the payload length).
  */
 template <
     size_t t_rxLen,
@@ -28,7 +63,11 @@ template <
     fit_value_t<t_rxLen> (*t_rxAvailable)(),
     uint8_t              (*t_rxRead)(),
     bool                 (*t_txReady)(),
-    void                 (*t_txWrite)(uint8_t)>
+    void                 (*t_txWrite)(uint8_t),
+    SerialTxMode t_txMode = SerialTxMode::serial,
+    typename t_Timer::TimerResolution t_txMinGapUs = t_eofTimeoutUs,
+    typename t_Framing = TimeoutFraming,
+    typename t_Crc = NoCrc>
 class Serial
 {
 private:
@@ -50,12 +89,31 @@ private:
         waitEof,
         idle,
         send,
-        waitTxComplete
+        waitTxComplete,
+        waitGap
     };
 public://extported types/constants
     static constexpr auto eofTimeout = typename t_Timer::IncPeriod(t_eofTimeoutUs);
+    static constexpr auto txMinGap   = typename t_Timer::IncPeriod(t_txMinGapUs);
     using RxIdxType  = fit_combinations_t<t_rxLen>;
     using TxIdxType  = fit_combinations_t<t_txLen>;
+    /**
+     * Payload area of a frame reserved with txFrameReserve().
+     * The TX ring may wrap inside the reserved area, so the payload is
+     * exposed as two contiguous regions (second is empty if no wrap).
+     */
+    struct TxFrameSlot
+    {
+        std::span<uint8_t> first;
+        std::span<uint8_t> second;
+        auto size() const -> size_t { return first.size() + second.size(); }
+        auto operator[](size_t idx) const -> uint8_t&
+        {
+            if( idx < first.size() )
+                return first[idx];
+            return second[idx-first.size()];
+        }
+    };
 public:
     //-------------
     // RX handler
@@ -95,6 +153,11 @@ public:
     {
         if( _rxst == RxState::shutdown )
             return;
+        if constexpr ( t_Framing::delimited )
+        {
+            rxTaskDelimited();
+            return;
+        }
         if( _rxst == RxState::init )
         {
             const auto cleanRxHardware = [&]()
@@ -129,6 +192,7 @@ public:
             }
             _rxTim.start();
             _rxFrameLen = 0;
+            _rxCrc.reset();
             
             //_rxFrameLenIdx points to the place where the FrameLen must be store
             _rxFrameLenIdx = _rxBuffer.getHead();
@@ -145,11 +209,7 @@ public:
             if( _rxTim >= eofTimeout )
             {
                 //frame completed (eof detected)
-                //set the length of the frame
-                SerializableT<RxIdxType> slen = _rxFrameLen;
-                for( uint8_t idx=0 ; idx<slen.size() ; idx++ )
-                    _rxBuffer.setDataAtAbsoluteIdx(_rxFrameLenIdx+idx,slen.raw[idx]);
-                _rxFrameCount++;
+                rxFrameComplete();
                 _rxst = RxState::idle;
                 return;
             }
@@ -168,12 +228,31 @@ public:
                 }
                 uint8_t data = t_rxRead();
                 _rxBuffer.put(data);
+                _rxCrc.update(data);
                 _rxFrameLen++;
             }
             _rxTim.start();
             return;
         }
     }
+    /*
+    Time until rxTask() has work even if no byte arrives (end of frame or
+    line idle timeouts), IncPeriod::max() if it only has work when
+    t_rxAvailable() != 0. Used to call the task only when needed (see
+    mcu::Scheduler).
+    */
+    auto rxWakeIn() const -> typename t_Timer::IncPeriod
+    {
+        using Period = typename t_Timer::IncPeriod;
+        if( _rxst == RxState::init )
+            return Period(0);
+        if constexpr ( !t_Framing::delimited )
+        {
+            if( _rxst == RxState::waitEof || _rxst == RxState::read )
+                return remaining(_rxTim,eofTimeout);
+        }
+        return Period::max();
+    }
     //-------------
     // TX handler
     //-------------
@@ -184,6 +263,7 @@ public:
         if( _txst == TxState::shutdown )
         {
             _txFrameCount = 0;
+            _txReserved = false;
             _txBuffer.clear();
             _txst = TxState::init;
         }
@@ -191,21 +271,105 @@ public:
     auto txFreeSpace() const -> TxIdxType
     {
         TxIdxType available = _txBuffer.freeSpace();
-        if( available >= sizeof(TxIdxType) )
-            return available - sizeof(TxIdxType);
+        if( available >= sizeof(TxIdxType) + t_Crc::size )
+            return available - sizeof(TxIdxType) - t_Crc::size;
         return 0;
     }
     auto txFrameAppend(const uint8_t* buff,TxIdxType len) -> bool
     {
-        if( _txBuffer.freeSpace() < len+sizeof(TxIdxType) )
+        if( _txReserved )
+            return false;
+        if( len > txFreeSpace() )
             return false;
-        SerializableT<TxIdxType> slen = len;
+        SerializableT<TxIdxType> slen = TxIdxType(len + t_Crc::size);
         _txBuffer.put(slen.raw,slen.size());
-        _txBuffer.put(buff,len);
+        t_Crc crc;
+        txPutPayload(buff,len,crc);
+        txPutCrc(crc);
         _txFrameCount++;
         return true;
     }
-    auto txFramesPending() -> TxIdxType
+    /**
+     * Vectored append: the segments are sent as a single frame (for instance
+     * header + payload + crc). The length is written once and each segment
+     * is copied straight into the tx buffer, no temporary buffer is needed.
+     * Either the whole frame is queued or nothing is.
+     */
+    auto txFrameAppend(std::span<const std::span<const uint8_t>> segments) -> bool
+    {
+        if( _txReserved )
+            return false;
+        size_t len = 0;
+        for( const auto& seg : segments )
+            len += seg.size();
+        if( len > txFreeSpace() )
+            return false;
+        SerializableT<TxIdxType> slen = TxIdxType(len + t_Crc::size);
+        _txBuffer.put(slen.raw,slen.size());
+        t_Crc crc;
+        for( const auto& seg : segments )
+            txPutPayload(seg.data(),TxIdxType(seg.size()),crc);
+        txPutCrc(crc);
+        _txFrameCount++;
+        return true;
+    }
+    auto txFrameAppend(std::initializer_list<std::span<const uint8_t>> segments) -> bool
+    {
+        return txFrameAppend(std::span<const std::span<const uint8_t>>(segments.begin(),segments.size()));
+    }
+    /**
+     * Reserve/commit append: reserves room for a frame of up to len bytes
+     * directly in the tx buffer, so the payload can be serialized in place.
+     * The frame is not sent until txFrameCommit() is called, and no other
+     * frame can be appended while a reservation is open.
+     */
+    auto txFrameReserve(TxIdxType len) -> std::optional<TxFrameSlot>
+    {
+        if( _txReserved )
+            return std::nullopt;
+        if( len > txFreeSpace() )
+            return std::nullopt;
+        _txReservedLenIdx = _txBuffer.getHead();
+        _txBuffer.put(nullptr,sizeof(TxIdxType));
+        //room for the crc is reserved too, but it is not exposed to the caller
+        auto [first,second] = _txBuffer.reserve(len + t_Crc::size);
+        _txSlot = TxFrameSlot{.first = first,.second = second};
+        _txReservedLen = len + t_Crc::size;
+        _txReserved = true;
+        if( first.size() >= len )
+            return TxFrameSlot{.first = first.first(len),.second = {}};
+        return TxFrameSlot{.first = first,.second = second.first(len-first.size())};
+    }
+    //commits the reserved frame, len may be smaller than the reserved length
+    auto txFrameCommit(TxIdxType len) -> bool
+    {
+        if( !_txReserved || len + t_Crc::size > _txReservedLen )
+            return false;
+        if constexpr ( t_Crc::size != 0 )
+        {
+            t_Crc crc;
+            size_t firstLen = std::min(_txSlot.first.size(),size_t(len));
+            crc.update(_txSlot.first.data(),firstLen);
+            crc.update(_txSlot.second.data(),len-firstLen);
+            for( size_t idx=0 ; idx<t_Crc::size ; idx++ )
+                _txSlot[len+idx] = crc.byteAt(idx);
+        }
+        _txBuffer.remove(_txReservedLen-len-t_Crc::size,true);
+        SerializableT<TxIdxType> slen = TxIdxType(len + t_Crc::size);
+        for( uint8_t idx=0 ; idx<slen.size() ; idx++ )
+            _txBuffer.setDataAtAbsoluteIdx((size_t(_txReservedLenIdx)+idx)%t_txLen,slen.raw[idx]);
+        _txReserved = false;
+        _txFrameCount++;
+        return true;
+    }
+    auto txFrameAbort() -> void
+    {
+        if( !_txReserved )
+            return;
+        _txBuffer.remove(_txReservedLen+sizeof(TxIdxType),true);
+        _txReserved = false;
+    }
+    auto txFramesPending() const -> TxIdxType
     {
         return _txFrameCount;
     }
@@ -230,11 +394,7 @@ public:
         {
             if( txFramesPending() == 0 )
                 return;
-            SerializableT<TxIdxType> slen;
-            for( TxIdxType idx=0 ; idx<slen.size() ; idx++ )
-                slen.raw[idx] = _txBuffer.peekAt(idx);
-            _txFrameLen = slen.value;
-            _txFrameIdx = 0;
+            txLoadFrame();
             _txst = TxState::send;
             return;
         }
@@ -242,6 +402,13 @@ public:
         {
             if( !t_txReady() )
                 return;
+            if constexpr ( t_Framing::delimited )
+            {
+                t_txWrite(_txEncoder.next([&](size_t idx){ return _txBuffer.peekAt(sizeof(TxIdxType) + idx); }));
+                if( _txEncoder.done() )
+                    _txst = TxState::waitTxComplete;
+                return;
+            }
             t_txWrite(_txBuffer.peekAt(sizeof(TxIdxType) + _txFrameIdx++));
             if( _txFrameIdx >= _txFrameLen )
                 _txst = TxState::waitTxComplete;
@@ -253,11 +420,163 @@ public:
                 return;
             _txBuffer.remove(_txFrameLen + sizeof(TxIdxType));
             _txFrameCount--;
-            _txst = TxState::init;
+            //the delimiter already ended the frame, no gap is needed
+            if constexpr ( t_Framing::delimited )
+                _txst = TxState::idle;
+            else if constexpr ( t_txMode == SerialTxMode::pipelined )
+            {
+                //the gap starts now: the last byte already left the uart
+                _txTim.start();
+                _txFrameLoaded = false;
+                _txst = TxState::waitGap;
+            }
+            else
+                _txst = TxState::init;
             return;
         }
+        if( _txst == TxState::waitGap )
+        {
+            //load the next frame while the gap runs
+            if( !_txFrameLoaded && txFramesPending() != 0 )
+            {
+                txLoadFrame();
+                _txFrameLoaded = true;
+            }
+            if( _txTim < txMinGap )
+                return;
+            _txst = _txFrameLoaded ? TxState::send : TxState::idle;
+            return;
+        }
+    }
+    //time until txTask() has work (IncPeriod::max(): nothing to send)
+    auto txWakeIn() const -> typename t_Timer::IncPeriod
+    {
+        using Period = typename t_Timer::IncPeriod;
+        if( _txst == TxState::shutdown )
+            return Period::max();
+        if( _txst == TxState::waitEof )
+            return remaining(_txTim,eofTimeout);
+        if( _txst == TxState::idle )
+            return txFramesPending() != 0 ? Period(0) : Period::max();
+        if( _txst == TxState::waitGap && (_txFrameLoaded || txFramesPending() == 0) )
+            return _txFrameLoaded ? remaining(_txTim,txMinGap) : Period::max();
+        //init, send and waitTxComplete poll the uart
+        return Period(0);
+    }
+private:
+    static auto remaining(const t_Timer& tim,typename t_Timer::IncPeriod timeout) -> typename t_Timer::IncPeriod
+    {
+        auto elapsed = tim.elapsed();
+        return elapsed >= timeout ? typename t_Timer::IncPeriod(0) : timeout - elapsed;
+    }
+    auto txLoadFrame() -> void
+    {
+        SerializableT<TxIdxType> slen;
+        for( TxIdxType idx=0 ; idx<slen.size() ; idx++ )
+            slen.raw[idx] = _txBuffer.peekAt(idx);
+        _txFrameLen = slen.value;
+        _txFrameIdx = 0;
+        if constexpr ( t_Framing::delimited )
+            _txEncoder.start(_txFrameLen);
     }
 #endif
+private:
+    auto txPutPayload(const uint8_t* buff,TxIdxType len,t_Crc& crc) -> void
+    {
+        _txBuffer.put(buff,len);
+        if constexpr ( t_Crc::size != 0 )
+        {
+            if( buff != nullptr )
+                crc.update(buff,len);
+            else
+                for( TxIdxType idx=0 ; idx<len ; idx++ )
+                    crc.update(uint8_t(0));
+        }
+    }
+    auto txPutCrc(const t_Crc& crc) -> void
+    {
+        for( size_t idx=0 ; idx<t_Crc::size ; idx++ )
+            _txBuffer.put(crc.byteAt(idx));
+    }
+    //sets the length of the frame being received (the crc is checked
+    //and stripped first)
+    auto rxFrameComplete() -> void
+    {
+        if constexpr ( t_Crc::size != 0 )
+        {
+            if( _rxFrameLen < t_Crc::size || !_rxCrc.check() )
+            {
+                _rxBuffer.remove(_rxFrameLen+sizeof(RxIdxType),true);
+                return;
+            }
+            _rxBuffer.remove(t_Crc::size,true);
+            _rxFrameLen -= t_Crc::size;
+        }
+        SerializableT<RxIdxType> slen = _rxFrameLen;
+        for( uint8_t idx=0 ; idx<slen.size() ; idx++ )
+            _rxBuffer.setDataAtAbsoluteIdx((size_t(_rxFrameLenIdx)+idx)%t_rxLen,slen.raw[idx]);
+        _rxFrameCount++;
+    }
+    auto rxTaskDelimited() -> void
+    {
+        if( _rxst == RxState::init )
+        {
+            _rxDecoder.reset();
+            _rxFrameOpen = false;
+            _rxst = RxState::read;
+            return;
+        }
+        const auto dropFrame = [&]()
+        {
+            if( !_rxFrameOpen )
+                return;
+            _rxBuffer.remove(_rxFrameLen+sizeof(RxIdxType),true);
+            _rxFrameOpen = false;
+        };
+        while( t_rxAvailable() )
+        {
+            uint8_t data = 0;
+            auto ret = _rxDecoder.feed(t_rxRead(),data);
+            if( ret == FramingResult::none )
+                continue;
+            if( ret == FramingResult::error )
+            {
+                dropFrame();
+                continue;
+            }
+            if( ret == FramingResult::eof )
+            {
+                if( !_rxFrameOpen )
+                    continue;
+                rxFrameComplete();
+                _rxFrameOpen = false;
+                continue;
+            }
+            if( !_rxFrameOpen )
+            {
+                //overflow: no space to store the input frame
+                if( _rxBuffer.freeSpace() <= sizeof(RxIdxType) )
+                {
+                    _rxDecoder.discard();
+                    continue;
+                }
+                _rxFrameLen = 0;
+                _rxCrc.reset();
+                _rxFrameLenIdx = _rxBuffer.getHead();
+                _rxBuffer.put(nullptr,sizeof(RxIdxType));
+                _rxFrameOpen = true;
+            }
+            if( _rxBuffer.isFull() )
+            {
+                dropFrame();
+                _rxDecoder.discard();
+                continue;
+            }
+            _rxBuffer.put(data);
+            _rxCrc.update(data);
+            _rxFrameLen++;
+        }
+    }
 private:
     mcu::FifoRaw<uint8_t,t_rxLen> _rxBuffer;
     mcu::FifoRaw<uint8_t,t_txLen> _txBuffer;
@@ -266,13 +585,212 @@ private:
     t_Timer _rxTim;
     t_Timer _txTim;
     //rx private
-    RxIdxType _rxFrameLen;
-    RxIdxType _rxFrameCount;
-    RxIdxType _rxFrameLenIdx;
+    RxIdxType _rxFrameLen = 0;
+    RxIdxType _rxFrameCount = 0;
+    RxIdxType _rxFrameLenIdx = 0;
     //tx private
-    TxIdxType _txFrameLen;
-    TxIdxType _txFrameCount;
-    TxIdxType _txFrameIdx;
+    TxIdxType _txFrameLen = 0;
+    TxIdxType _txFrameCount = 0;
+    TxIdxType _txFrameIdx = 0;
+    TxIdxType _txReservedLen = 0;
+    TxIdxType _txReservedLenIdx = 0;
+    bool      _txReserved = false;
+    bool      _txFrameLoaded = false;
+    [[no_unique_address]] typename t_Framing::Encoder _txEncoder;
+    TxFrameSlot _txSlot;
+    //rx private (delimited framing)
+    [[no_unique_address]] typename t_Framing::Decoder _rxDecoder;
+    bool      _rxFrameOpen = false;
+    //crc
+    [[no_unique_address]] t_Crc _rxCrc;
+};
+
+/**
+ * Reliable byte stream on top of the (unreliable) frames of mcu::Serial.
+ *
+ * The stream is split into segments of up to t_segLen bytes, each one sent
+ * in a Serial frame:
+ *  DATA: type(0x01) seq payload...
+ *  ACK:  type(0x02) ack            <- ack: next seq expected by the receiver
+ * Up to t_window segments (a power of two, so that the slots of the 8 bit
+ * sequence numbers do not move when they wrap) are in flight without
+ * waiting for the ack (sliding window), the acks are cumulative and the oldest unacknowledged
+ * segment is guarded by a retransmission timer (t_rtoUs): on expiry every
+ * segment in flight is sent again (go-back-N). Segments received out of
+ * order are dropped and the last ack is repeated, so the data is delivered
+ * in order. If the rx stream buffer has no room for a segment it is not
+ * acknowledged (flow control).
+ *
+ * The Serial frames should carry a crc (t_Crc), a corrupted segment must be
+ * dropped by Serial, not delivered. Serial::rxTask/txTask must still be
+ * called by the application, task() only runs the protocol.
+ *
+ * Example:
+ *  using Socket = mcu::StreamSocket<MySerial,Tim32_us,20000,512,512>;
+ *  Socket socket(serial);
+ *  socket.write(data,len);
+ *  ...
+ *  serial.rxTask(); socket.task(); serial.txTask();
+ *  len = socket.read(buff,sizeof(buff));
+ */
+template<typename t_Serial,
+         typename t_Timer,
+         typename t_Timer::TimerResolution t_rtoUs,
+         size_t   t_txLen,
+         size_t   t_rxLen,
+         uint8_t  t_window = 8,
+         size_t   t_segLen = 64>
+class StreamSocket
+{
+private:
+    static_assert(t_window > 0 && t_window < 128,"t_window must be in the range [1,127]");
+    static_assert((t_window & (t_window-1)) == 0,"t_window must be a power of two (seq%t_window must survive the 8 bit wrap)");
+    static_assert(t_segLen > 0,"t_segLen must be greater than zero");
+    enum class SegType : uint8_t
+    {
+        data = 0x01,
+        ack  = 0x02
+    };
+    static constexpr size_t headerLen = 2;
+public:
+    using TxIdxType = fit_combinations_t<t_txLen>;
+    using RxIdxType = fit_combinations_t<t_rxLen>;
+    static constexpr auto rto = typename t_Timer::IncPeriod(t_rtoUs);
+public:
+    StreamSocket(t_Serial& serial) : _serial(serial) {}
+    //returns the amount of bytes accepted
+    auto write(const uint8_t* buff,TxIdxType len) -> TxIdxType
+    {
+        return _txStream.put(buff,std::min(len,txFreeSpace()));
+    }
+    auto txFreeSpace() const -> TxIdxType { return _txStream.freeSpace(); }
+    //bytes written but not acknowledged yet
+    auto txPending() const -> TxIdxType { return _txStream.length(); }
+    auto read(uint8_t* buff,RxIdxType len) -> RxIdxType
+    {
+        RxIdxType count = 0;
+        while( count < len && !_rxStream.isEmpty() )
+            buff[count++] = _rxStream.get();
+        return count;
+    }
+    auto available() const -> RxIdxType { return _rxStream.length(); }
+    auto task() -> void
+    {
+        rxTask();
+        txTask();
+    }
+private:
+    auto inFlight() const -> uint8_t { return uint8_t(_txNext - _txBase); }
+    auto rxTask() -> void
+    {
+        while( _serial.rxFramesAvailable() != 0 )
+        {
+            auto len = _serial.rxFrameLength();
+            if( len >= headerLen )
+            {
+                auto type = SegType(_serial.rxFramePeekAt(0));
+                uint8_t seq = _serial.rxFramePeekAt(1);
+                if( type == SegType::ack )
+                    handleAck(seq);
+                else if( type == SegType::data )
+                {
+                    size_t dataLen = len - headerLen;
+                    if( seq == _rxExpected && _rxStream.freeSpace() >= dataLen )
+                    {
+                        for( size_t idx=0 ; idx<dataLen ; idx++ )
+                            _rxStream.put(_serial.rxFramePeekAt(headerLen+idx));
+                        _rxExpected++;
+                    }
+                    //in order or not, (re)send the cumulative ack
+                    _ackPending = true;
+                }
+            }
+            _serial.rxFrameDiscard();
+        }
+    }
+    auto handleAck(uint8_t ack) -> void
+    {
+        uint8_t count = uint8_t(ack - _txBase);
+        if( count == 0 || count > _txSegs )
+            return;
+        size_t bytes = 0;
+        for( uint8_t idx=0 ; idx<count ; idx++ )
+            bytes += _segLen[uint8_t(_txBase+idx)%t_window];
+        _txStream.remove(TxIdxType(bytes));
+        if( inFlight() < count )
+        {
+            //acked segments that were scheduled for retransmission
+            _txNext = ack;
+            _txNextOffset = 0;
+        }
+        else
+            _txNextOffset -= bytes;
+        _txBase = ack;
+        _txSegs -= count;
+        _rtoTim.start();
+    }
+    auto txTask() -> void
+    {
+        if( _ackPending )
+        {
+            uint8_t header[headerLen] = {uint8_t(SegType::ack),_rxExpected};
+            if( _serial.txFrameAppend(header,headerLen) )
+                _ackPending = false;
+        }
+        if( inFlight() != 0 && _rtoTim >= rto )
+        {
+            //go back N: resend every segment in flight
+            _txNext = _txBase;
+            _txNextOffset = 0;
+            _rtoTim.start();
+        }
+        while( inFlight() < t_window )
+        {
+            uint8_t segIdx = _txNext % t_window;
+            size_t len;
+            if( inFlight() < _txSegs )
+                len = _segLen[segIdx];
+            else
+            {
+                len = std::min<size_t>(t_segLen,_txStream.length()-_txNextOffset);
+                if( len == 0 )
+                    return;
+            }
+            auto slot = _serial.txFrameReserve(len+headerLen);
+            if( !slot.has_value() )
+                return;
+            auto& frame = slot.value();
+            frame[0] = uint8_t(SegType::data);
+            frame[1] = _txNext;
+            for( size_t idx=0 ; idx<len ; idx++ )
+                frame[headerLen+idx] = _txStream.peekAt(_txNextOffset+idx);
+            _serial.txFrameCommit(len+headerLen);
+            if( inFlight() == _txSegs )
+            {
+                _segLen[segIdx] = len;
+                _txSegs++;
+            }
+            if( inFlight() == 0 )
+                _rtoTim.start();
+            _txNext++;
+            _txNextOffset += len;
+        }
+    }
+private:
+    t_Serial& _serial;
+    mcu::FifoRaw<uint8_t,t_txLen> _txStream;
+    mcu::FifoRaw<uint8_t,t_rxLen> _rxStream;
+    t_Timer _rtoTim;
+    //tx: segments [_txBase,_txBase+_txSegs) were built from _txStream,
+    //[_txBase,_txNext) are in flight
+    std::array<size_t,t_window> _segLen{};
+    uint8_t _txBase = 0;
+    uint8_t _txNext = 0;
+    uint8_t _txSegs = 0;
+    size_t  _txNextOffset = 0;
+    //rx
+    uint8_t _rxExpected = 0;
+    bool    _ackPending = false;
 };
 }//namespace mcu
 
@@ -6,11 +6,11 @@
 namespace mcu
 {
 
-template<typename T,size_t t_len>
+template<typename T,size_t t_len,StoragePolicy t_policy = default_storage_policy>
 class CircularSpan
 {
 public:
-    using IdxType = fit_combinations_t<t_len>;
+    using IdxType = index_t<t_len,t_policy>;
 public:
     CircularSpan()
         : _buff(nullptr), _len(0), _tail(0), _head(0){}
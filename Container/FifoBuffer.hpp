@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <tuple>
+#include <span>
+#include <utility>
 #include <cstdint>
 #include "../Utils/TypeUtils.hpp"
 #include "CircularSpan.hpp"
@@ -9,14 +11,16 @@
 namespace mcu
 {
 
-template<typename    t_DataType,
-         size_t      t_buffLen,
-         bool        t_override = false>
+template<typename      t_DataType,
+         size_t        t_buffLen,
+         bool          t_override = false,
+         StoragePolicy t_policy   = default_storage_policy>
 class FifoBuffer
 {
 public:
     static constexpr auto maxLen = t_buffLen;
-    using IdxType = fit_combinations_t<t_buffLen>;
+    using IdxType = index_t<t_buffLen,t_policy>;
+    using CircularSpanType = CircularSpan<t_DataType,t_buffLen,t_policy>;
 public:
     FifoBuffer(/*bool deepClean=false*/){ clear(/*deepClean*/); }
     void 	    put(const t_DataType& data)
@@ -127,14 +131,14 @@ public:
     {
         return t_buffLen - length() - 1;
     }
-    CircularSpan<t_DataType,t_buffLen> getCircularSpan() const
+    CircularSpanType getCircularSpan() const
     {
-        return CircularSpan<t_DataType,t_buffLen>(_buff,length(),_tail,_head);
+        return CircularSpanType(_buff,length(),_tail,_head);
     }
-    CircularSpan<t_DataType,t_buffLen> getCircularSpan(IdxType len) const
+    CircularSpanType getCircularSpan(IdxType len) const
     {
         if( length() <= len )
-            return CircularSpan<t_DataType,t_buffLen>(_buff,length(),_tail,_head);
+            return CircularSpanType(_buff,length(),_tail,_head);
         IdxType idx = len;
         IdxType head = 0;
         idx %= length();
@@ -148,7 +152,7 @@ public:
                 head = _tail+idx-t_buffLen;
         }
         head = incIdx(head);
-        return CircularSpan<t_DataType,t_buffLen>(_buff,len,_tail,head);
+        return CircularSpanType(_buff,len,_tail,head);
     }
 //    FifoBuffer<t_DataType,t_buffLen,t_override> strip(IdxType startIdx,IdxType count) const
 //    {
@@ -174,19 +178,21 @@ protected:
         return _buff[_tail+idx-t_buffLen];
     }
 protected:
-    t_DataType  _buff[t_buffLen];
+    alignas(storage_align_v<t_DataType,t_policy>) t_DataType _buff[t_buffLen];
     IdxType     _tail   = 0;
     IdxType     _head   = 0;
 };
 
 
-template<   typename    t_DataType,
-         size_t      t_buffLen,
-         bool        t_override = false>
+template<typename      t_DataType,
+         size_t        t_buffLen,
+         bool          t_override = false,
+         StoragePolicy t_policy   = default_storage_policy>
 class FifoRaw
 {
 public:
-    using IdxType = decltype(fit_combinations_t<t_buffLen>());
+    using IdxType = index_t<t_buffLen,t_policy>;
+    using CircularSpanType = CircularSpan<t_DataType,t_buffLen,t_policy>;
     static constexpr IdxType maxLen(){ return t_buffLen; }
 public:
     FifoRaw(/*bool deepClean=false*/){ clear(/*deepClean*/); }
@@ -363,6 +369,19 @@ public:
             return _buff[_tail+idx];
         return _buff[_tail+idx-t_buffLen];
     }
+    //advances the head by len items without writing them and returns the
+    //(up to two, because of the wrap) contiguous regions that were reserved,
+    //so the caller can fill them in place
+    std::pair<std::span<t_DataType>,std::span<t_DataType>> reserve(IdxType len)
+    {
+        if( len > freeSpace() )
+            return {};
+        IdxType first = std::min<size_t>(len,t_buffLen-_head);
+        std::span<t_DataType> lo(_buff+_head,first);
+        std::span<t_DataType> hi(_buff,len-first);
+        _head = IdxType((size_t(_head)+len)%t_buffLen);
+        return {lo,hi};
+    }
     IdxType     getHead() const
     {
         return _head;
@@ -393,9 +412,9 @@ public:
             return _buff[_tail+idx];
         return _buff[_tail+idx-t_buffLen];
     }
-    CircularSpan<t_DataType,t_buffLen> getCircularSpan() const
+    CircularSpanType getCircularSpan() const
     {
-        return CircularSpan<t_DataType,t_buffLen>(_buff,length(),_tail,_head);
+        return CircularSpanType(_buff,length(),_tail,_head);
     }
 protected:
     IdxType     incIdx(IdxType idx) const
@@ -405,7 +424,7 @@ protected:
         return idx + 1;
     }
 protected:
-    t_DataType  _buff[t_buffLen];
+    alignas(storage_align_v<t_DataType,t_policy>) t_DataType _buff[t_buffLen];
     IdxType     _tail   = 0;
     IdxType     _head   = 0;
 };
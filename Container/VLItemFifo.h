@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <optional>
 #include "../Utils/SerializableT.hpp"
 #include "../Utils/TypeUtils.hpp"
@@ -14,18 +15,21 @@
 namespace mcu
 {
 
-template<typename    t_DataType,
-         size_t      t_buffLen,
-         size_t      t_itemLen = std::min<size_t>(t_buffLen,
-                                                  max_val_storable_on<fit_value_t<t_buffLen>>())//static_cast<fit_value_t<t_buffLen>>(~size_t(0))
+template<typename      t_DataType,
+         size_t        t_buffLen,
+         size_t        t_itemLen = std::min<size_t>(t_buffLen,
+                                                    max_val_storable_on<fit_value_t<t_buffLen>>()),//static_cast<fit_value_t<t_buffLen>>(~size_t(0))
+         StoragePolicy t_policy  = default_storage_policy
         >
 class VLItemFifo
 {
     static_assert( t_buffLen >= t_itemLen , "t_buffLen must be greater than t_itemLen" );
 public:
     static constexpr auto maxLen = t_buffLen;
-    using IdxType = fit_combinations_t<t_buffLen>;
+    using IdxType = index_t<t_buffLen,t_policy>;
+    using CircularSpanType = CircularSpan<t_DataType,t_buffLen,t_policy>;
 private:
+    //stored in the buffer, so it does not depend on the policy
     using SofType = fit_value_t<t_itemLen>;
 public:
     VLItemFifo(){ clear(); }
@@ -55,13 +59,12 @@ public:
             for( SofType i=0 ; i<sizeof(SofType) ; i++ )
                 incHead();
         }
-        SerializableT<T> sdata;
-        sdata.value = data;
-        for( const auto& item : sdata.raw )
-        {
-            _buff[_head] = item;
-            incHead();
-        }
+        //one copy (two if the item wraps around the end of the buffer)
+        auto raw = std::bit_cast<std::array<uint8_t,sizeof(T)>>(data);
+        size_t first = std::min<size_t>(sizeof(T),t_buffLen-_head);
+        std::copy_n(raw.begin(),first,_buff.begin()+_head);
+        std::copy_n(raw.begin()+first,sizeof(T)-first,_buff.begin());
+        _head = incIdx(_head,sizeof(T));
         incSof(sizeof(T));
     }
     auto pop() -> void
@@ -80,12 +83,12 @@ public:
             tail = incIdx(tail);
     	return _buff[tail];
     }
-    CircularSpan<t_DataType,t_buffLen> getCircularSpan() const
+    CircularSpanType getCircularSpan() const
     {
         IdxType tail = _tail;
         for( SofType i=0 ; i<sizeof(SofType) ; i++ )
             tail = incIdx(tail);
-        return CircularSpan<t_DataType,t_buffLen>(_buff.data(),firstItemLength(),tail,_head);
+        return CircularSpanType(_buff.data(),firstItemLength(),tail,_head);
     }
     auto clear() -> void
     {
@@ -203,7 +206,7 @@ protected:
     }
     auto incIdx(IdxType idx,IdxType len) const -> IdxType { return (idx+len)%t_buffLen; }
 protected:
-    std::array<t_DataType,t_buffLen> _buff;
+    alignas(storage_align_v<t_DataType,t_policy>) std::array<t_DataType,t_buffLen> _buff;
     IdxType     _tail   = 0;
     IdxType     _head   = 0;
     IdxType     _itemsCount = 0;
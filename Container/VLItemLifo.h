@@ -1,7 +1,8 @@
 #pragma once
 #include "../Utils/TypeUtils.hpp"
-#include "../Utils/SerializableT.hpp"
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <span>
 #include <optional>
 #include <string_view>
@@ -58,7 +59,6 @@ public:
         {
             return _buff[t_buffLen-(3+itemIdx)*sizeof(IdxType)];
         };
-        auto iC = itemsCount();
         if( itemIdx >= itemsCount() )
             return std::nullopt;
         IdxType startIndex = startIdx(itemIdx);
@@ -66,12 +66,7 @@ public:
         if( itemIdx == itemsCount()-1 )
             len = tos() - startIdx(itemIdx);
         else
-        {
-            if( itemIdx == 0 )
-                len = startIdx(itemIdx+1);
-            else
-                len = startIdx(itemIdx) - startIdx(itemIdx-1);
-        }
+            len = startIdx(itemIdx+1) - startIdx(itemIdx);
         std::span span{_buff.data()+startIndex,len};
 //        const ItemInfo item{.data = _buff.data()+startIndex , .len = len};
         return {span};
@@ -105,17 +100,23 @@ public:
     {
         if( freeSpace() < sizeof(T) )
             return false;
-        SerializableT<T> sdata(data);
+        auto raw = std::bit_cast<std::array<uint8_t,sizeof(T)>>(data);
         auto startIdx = tos();
         nextEmptyStartIdx() = startIdx;
-        for( IdxType i=0 ; i<sizeof(T) ; i++ )
-        {
-            _buff[startIdx++] = sdata.raw[i];
-        }
+        std::copy_n(raw.begin(),sizeof(T),_buff.begin()+startIdx);
         tos() += sizeof(T);
         len()++;
         return true;
     }
+    //starts a new item with no data, filled with appendByteToItem()
+    bool pushEmptyItem()
+    {
+        if( freeSpace() == 0 )
+            return false;
+        nextEmptyStartIdx() = tos();
+        len()++;
+        return true;
+    }
     bool appendByteToItem(uint8_t data)
     {
         if( freeSpace() == 0 )
@@ -145,11 +146,11 @@ public:
         IdxType len = tos() - startIdx;
         if( len != sizeof(T) )
             return std::nullopt;
-        SerializableT<T> aux;
-        aux.copyFrom(_buff.data()+startIdx);
+        std::array<uint8_t,sizeof(T)> raw;
+        std::copy_n(_buff.begin()+startIdx,sizeof(T),raw.begin());
         (this->len())--;
         tos() -= sizeof(T);
-        return {aux.value};
+        return {std::bit_cast<T>(raw)};
     }
     bool isEmpty() const { return itemsCount() == 0; }
     IdxType freeSpace() const
@@ -0,0 +1,97 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_dispatch_x86.h
+ * Description:  Runtime selection of the x86 versions of the DSP functions
+ *
+ * Target Processor: x86 hosts
+ * -------------------------------------------------------------------- */
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ARM_DISPATCH_X86_H
+#define _ARM_DISPATCH_X86_H
+
+#include "arm_math.h"
+
+#ifdef   __cplusplus
+extern "C"
+{
+#endif
+
+  /**
+   * @brief Instruction sets of the x86 versions, in increasing order.
+   *
+   * When the library is built with ARM_MATH_X86_DISPATCH, the functions below are
+   * compiled once per instruction set and bound at run time from cpuid:
+   * arm_dot_prod_f32/q31/q15/q7 (the functions with ARM_MATH_X86_SSE2/AVX2 intrinsic
+   * versions that gain from a wider instruction set, the others are not dispatched).
+   * Their prototypes do not change. The first call of any of them binds the best
+   * instruction set. The binding is one atomic pointer to a constant table, so the
+   * functions can be called, and arm_dispatch_x86_init() or arm_dispatch_x86_select()
+   * called, from any thread.
+   *
+   * The versions are built without floating-point contraction (AVX-512F has FMA
+   * instructions), the results are identical whatever the instruction set except
+   * arm_dot_prod_f32 (partial sums in a different order).
+   */
+  typedef enum
+  {
+    ARM_X86_ISA_SSE2 = 0,   /**< x86-64 baseline */
+    ARM_X86_ISA_SSE41,      /**< SSE4.1 */
+    ARM_X86_ISA_AVX2,       /**< AVX2 (Haswell and later) */
+    ARM_X86_ISA_AVX512,     /**< AVX-512 F, BW, DQ and VL (Skylake-SP and later) */
+    ARM_X86_ISA_COUNT
+  } arm_x86_isa;
+
+  /**
+   * @brief Best instruction set supported by the processor and the OS.
+   * @return the instruction set
+   */
+  arm_x86_isa arm_dispatch_x86_detect(void);
+
+  /**
+   * @brief Binds the functions to the best instruction set.
+   * @return the selected instruction set
+   */
+  arm_x86_isa arm_dispatch_x86_init(void);
+
+  /**
+   * @brief Binds the functions to an instruction set (comparisons, benchmarks).
+   * @param[in] isa instruction set
+   * @return ARM_MATH_ARGUMENT_ERROR if the processor does not support it
+   */
+  arm_status arm_dispatch_x86_select(
+        arm_x86_isa isa);
+
+  /**
+   * @brief Instruction set the functions are bound to.
+   * @return the instruction set (the best one, bound by this call, if none was bound yet)
+   */
+  arm_x86_isa arm_dispatch_x86_current(void);
+
+  /**
+   * @brief Name of an instruction set ("sse2", "sse4.1", "avx2", "avx512").
+   * @param[in] isa instruction set
+   * @return the name
+   */
+  const char * arm_dispatch_x86_name(
+        arm_x86_isa isa);
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif /* _ARM_DISPATCH_X86_H */
@@ -128,6 +128,23 @@
    * of some DSP functions. Experimental Neon versions currently do not have better
    * performances than the scalar versions.
    *
+   * - ARM_MATH_X86_SSE2, ARM_MATH_X86_AVX2:
+   *
+   * Define macro ARM_MATH_X86_SSE2 (or ARM_MATH_X86_AVX2, which implies it) to enable the
+   * SSE2/AVX2 versions of the basic math functions when the library is built for x86 hosts
+   * (simulation, offline replay). The compiler must target the instruction set (-msse2, -mavx2).
+   * The results are bit exact with the scalar versions, saturation included, except the
+   * floating-point dot product (partial sums are added in a different order). The 128-bit
+   * paths of the Q31 multiply, scale and dot product need SSE4.1 (-msse4.1), without it they
+   * use the scalar loop.
+   *
+   * - ARM_MATH_X86_DISPATCH:
+   *
+   * Define macro ARM_MATH_X86_DISPATCH (GCC, x86 hosts) to build the dot product functions once
+   * per instruction set (SSE2, SSE4.1, AVX2, AVX-512) and bind them at run time from cpuid, so one
+   * binary runs everywhere. The prototypes do not change, see arm_dispatch_x86.h for the list and
+   * the selection functions.
+   *
    * <hr>
    * CMSIS-DSP in ARM::CMSIS Pack
    * -----------------------------
@@ -339,6 +356,14 @@ extern "C"
 
 #if defined(__ARM_NEON)
 #include <arm_neon.h>
+#endif
+
+#if defined(ARM_MATH_X86_AVX2) && !defined(ARM_MATH_X86_SSE2)
+  #define ARM_MATH_X86_SSE2
+#endif
+
+#if defined(ARM_MATH_X86_SSE2)
+#include "arm_math_x86.h"
 #endif
 
   /**
@@ -437,6 +462,19 @@ extern "C"
       return (x);
   }
 
+  /**
+   * @brief Rotate right, the hosts do not include cmsis_compiler.h.
+   */
+  static inline uint32_t __ROR(uint32_t op1, uint32_t op2)
+  {
+    op2 %= 32U;
+    if (op2 == 0U)
+    {
+      return op1;
+    }
+    return (op1 >> op2) | (op1 << (32U - op2));
+  }
+
   /**
   @brief definition to read/write two 16 bit values.
   @deprecated
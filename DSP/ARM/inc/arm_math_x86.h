@@ -0,0 +1,119 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_math_x86.h
+ * Description:  Helpers for the SSE2/AVX2 versions of the DSP functions
+ *
+ * Target Processor: x86 hosts
+ * -------------------------------------------------------------------- */
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ARM_MATH_X86_H
+#define _ARM_MATH_X86_H
+
+#if !defined(__SSE2__) && !defined(_M_X64) && !(defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+  #error "ARM_MATH_X86_SSE2 needs a compiler targeting SSE2"
+#endif
+
+#if defined(ARM_MATH_X86_AVX2) && !defined(__AVX2__)
+  #error "ARM_MATH_X86_AVX2 needs a compiler targeting AVX2 (-mavx2)"
+#endif
+
+#include <immintrin.h>
+
+/**
+ * @brief Sign extension of the low (high) 8 q7 of a to q15.
+ */
+static inline __m128i x86_cvtlo_q7_q15(__m128i a)
+{
+  return _mm_srai_epi16(_mm_unpacklo_epi8(a, a), 8);
+}
+
+static inline __m128i x86_cvthi_q7_q15(__m128i a)
+{
+  return _mm_srai_epi16(_mm_unpackhi_epi8(a, a), 8);
+}
+
+/**
+ * @brief Sign extension of the low (high) 2 q31 of a to q63.
+ */
+static inline __m128i x86_cvtlo_q31_q63(__m128i a)
+{
+  return _mm_unpacklo_epi32(a, _mm_srai_epi32(a, 31));
+}
+
+static inline __m128i x86_cvthi_q31_q63(__m128i a)
+{
+  return _mm_unpackhi_epi32(a, _mm_srai_epi32(a, 31));
+}
+
+/**
+ * @brief Arithmetic right shift of 64-bit lanes (no SSE/AVX2 instruction).
+ */
+static inline __m128i x86_srai_q63(__m128i a, int n)
+{
+  __m128i sign = _mm_shuffle_epi32(_mm_srai_epi32(a, 31), _MM_SHUFFLE(3, 3, 1, 1));
+  return _mm_or_si128(_mm_srli_epi64(a, n), _mm_slli_epi64(sign, 64 - n));
+}
+
+/**
+ * @brief Saturating addition of q31 lanes (__QADD).
+ */
+static inline __m128i x86_qadd_q31(__m128i a, __m128i b)
+{
+  __m128i sum = _mm_add_epi32(a, b);
+  /* overflow when the sign of the sum differs from both operands */
+  __m128i ovf = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(a, sum), _mm_xor_si128(b, sum)), 31);
+  __m128i sat = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(0x7FFFFFFF));
+  return _mm_or_si128(_mm_and_si128(ovf, sat), _mm_andnot_si128(ovf, sum));
+}
+
+#if defined(__SSE4_1__)
+/**
+ * @brief High part of the q31 products: ((q63_t) a * b) >> 32.
+ */
+static inline __m128i x86_mulhi_q31(__m128i a, __m128i b)
+{
+  __m128i even = _mm_mul_epi32(a, b);
+  __m128i odd  = _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xCC);
+}
+#endif
+
+#if defined(ARM_MATH_X86_AVX2)
+static inline __m256i x86_srai_q63_256(__m256i a, int n)
+{
+  __m256i sign = _mm256_shuffle_epi32(_mm256_srai_epi32(a, 31), _MM_SHUFFLE(3, 3, 1, 1));
+  return _mm256_or_si256(_mm256_srli_epi64(a, n), _mm256_slli_epi64(sign, 64 - n));
+}
+
+static inline __m256i x86_qadd_q31_256(__m256i a, __m256i b)
+{
+  __m256i sum = _mm256_add_epi32(a, b);
+  __m256i ovf = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(a, sum), _mm256_xor_si256(b, sum)), 31);
+  __m256i sat = _mm256_xor_si256(_mm256_srai_epi32(a, 31), _mm256_set1_epi32(0x7FFFFFFF));
+  return _mm256_blendv_epi8(sum, sat, ovf);
+}
+
+static inline __m256i x86_mulhi_q31_256(__m256i a, __m256i b)
+{
+  __m256i even = _mm256_mul_epi32(a, b);
+  __m256i odd  = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+  return _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+#endif /* defined(ARM_MATH_X86_AVX2) */
+
+#endif /* _ARM_MATH_X86_H */
@@ -94,6 +94,52 @@ void arm_abs_f32(
     /* Tail */
     blkCnt = blockSize & 0x3;
 
+#elif defined (ARM_MATH_X86_SSE2)
+
+  const __m128 sign128 = _mm_set1_ps(-0.0f);
+
+#if defined (ARM_MATH_X86_AVX2)
+  const __m256 sign256 = _mm256_set1_ps(-0.0f);
+
+  /* Compute 8 outputs at a time */
+  blkCnt = blockSize >> 3U;
+
+  while (blkCnt > 0U)
+  {
+    /* C = |A|, clears the sign bit */
+    _mm256_storeu_ps(pDst, _mm256_andnot_ps(sign256, _mm256_loadu_ps(pSrc)));
+
+    /* Increment pointers */
+    pSrc += 8;
+    pDst += 8;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0x7U) >> 2U;
+#else
+  /* Compute 4 outputs at a time */
+  blkCnt = blockSize >> 2U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* C = |A|, clears the sign bit */
+    _mm_storeu_ps(pDst, _mm_andnot_ps(sign128, _mm_loadu_ps(pSrc)));
+
+    /* Increment pointers */
+    pSrc += 4;
+    pDst += 4;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Tail */
+  blkCnt = blockSize & 0x3U;
+
 #else
 #if defined (ARM_MATH_LOOPUNROLL)
 
@@ -57,7 +57,57 @@ void arm_abs_q15(
         uint32_t blkCnt;                               /* Loop counter */
         q15_t in;                                      /* Temporary input variable */
 
-#if defined (ARM_MATH_LOOPUNROLL)
+#if defined (ARM_MATH_X86_SSE2)
+
+  const __m128i zero128 = _mm_setzero_si128();
+
+#if defined (ARM_MATH_X86_AVX2)
+  const __m256i zero256 = _mm256_setzero_si256();
+
+  /* Compute 16 outputs at a time */
+  blkCnt = blockSize >> 4U;
+
+  while (blkCnt > 0U)
+  {
+    /* C = |A| (0x8000 saturated to 0x7fff) */
+    __m256i a = _mm256_loadu_si256((const __m256i *) pSrc);
+
+    _mm256_storeu_si256((__m256i *) pDst, _mm256_max_epi16(a, _mm256_subs_epi16(zero256, a)));
+
+    /* Increment pointers */
+    pSrc += 16;
+    pDst += 16;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0xFU) >> 3U;
+#else
+  /* Compute 8 outputs at a time */
+  blkCnt = blockSize >> 3U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* C = |A| (0x8000 saturated to 0x7fff) */
+    __m128i a = _mm_loadu_si128((const __m128i *) pSrc);
+
+    _mm_storeu_si128((__m128i *) pDst, _mm_max_epi16(a, _mm_subs_epi16(zero128, a)));
+
+    /* Increment pointers */
+    pSrc += 8;
+    pDst += 8;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Tail */
+  blkCnt = blockSize & 0x7U;
+
+#elif defined (ARM_MATH_LOOPUNROLL)
 
   /* Loop unrolling: Compute 4 outputs at a time */
   blkCnt = blockSize >> 2U;
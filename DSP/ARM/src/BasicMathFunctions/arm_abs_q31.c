@@ -57,7 +57,60 @@ void arm_abs_q31(
         uint32_t blkCnt;                               /* Loop counter */
         q31_t in;                                      /* Temporary variable */
 
-#if defined (ARM_MATH_LOOPUNROLL)
+#if defined (ARM_MATH_X86_SSE2)
+
+#if defined (ARM_MATH_X86_AVX2)
+
+  /* Compute 8 outputs at a time */
+  blkCnt = blockSize >> 3U;
+
+  while (blkCnt > 0U)
+  {
+    /* C = |A| (0x80000000 saturated to 0x7fffffff) */
+    __m256i a = _mm256_loadu_si256((const __m256i *) pSrc);
+    __m256i s = _mm256_srai_epi32(a, 31);
+    /* |A| wraps 0x80000000 to itself, adding its sign bit gives 0x7FFFFFFF */
+    __m256i r = _mm256_sub_epi32(_mm256_xor_si256(a, s), s);
+
+    _mm256_storeu_si256((__m256i *) pDst, _mm256_add_epi32(r, _mm256_srai_epi32(r, 31)));
+
+    /* Increment pointers */
+    pSrc += 8;
+    pDst += 8;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0x7U) >> 2U;
+#else
+  /* Compute 4 outputs at a time */
+  blkCnt = blockSize >> 2U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* C = |A| (0x80000000 saturated to 0x7fffffff) */
+    __m128i a = _mm_loadu_si128((const __m128i *) pSrc);
+    __m128i s = _mm_srai_epi32(a, 31);
+    /* |A| wraps 0x80000000 to itself, adding its sign bit gives 0x7FFFFFFF */
+    __m128i r = _mm_sub_epi32(_mm_xor_si128(a, s), s);
+
+    _mm_storeu_si128((__m128i *) pDst, _mm_add_epi32(r, _mm_srai_epi32(r, 31)));
+
+    /* Increment pointers */
+    pSrc += 4;
+    pDst += 4;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Tail */
+  blkCnt = blockSize & 0x3U;
+
+#elif defined (ARM_MATH_LOOPUNROLL)
 
   /* Loop unrolling: Compute 4 outputs at a time */
   blkCnt = blockSize >> 2U;
@@ -59,7 +59,59 @@ void arm_abs_q7(
         uint32_t blkCnt;                               /* Loop counter */
         q7_t in;                                       /* Temporary input variable */
 
-#if defined (ARM_MATH_LOOPUNROLL)
+#if defined (ARM_MATH_X86_SSE2)
+
+  const __m128i zero128 = _mm_setzero_si128();
+
+#if defined (ARM_MATH_X86_AVX2)
+  const __m256i zero256 = _mm256_setzero_si256();
+
+  /* Compute 32 outputs at a time */
+  blkCnt = blockSize >> 5U;
+
+  while (blkCnt > 0U)
+  {
+    /* C = |A| (0x80 saturated to 0x7f) */
+    __m256i a = _mm256_loadu_si256((const __m256i *) pSrc);
+
+    _mm256_storeu_si256((__m256i *) pDst, _mm256_max_epi8(a, _mm256_subs_epi8(zero256, a)));
+
+    /* Increment pointers */
+    pSrc += 32;
+    pDst += 32;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0x1FU) >> 4U;
+#else
+  /* Compute 16 outputs at a time */
+  blkCnt = blockSize >> 4U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* C = |A| (0x80 saturated to 0x7f) */
+    __m128i a = _mm_loadu_si128((const __m128i *) pSrc);
+    /* no signed byte max in SSE2: select the saturated negation for the negative inputs */
+    __m128i neg = _mm_cmpgt_epi8(zero128, a);
+
+    _mm_storeu_si128((__m128i *) pDst, _mm_or_si128(_mm_and_si128(neg, _mm_subs_epi8(zero128, a)), _mm_andnot_si128(neg, a)));
+
+    /* Increment pointers */
+    pSrc += 16;
+    pDst += 16;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Tail */
+  blkCnt = blockSize & 0xFU;
+
+#elif defined (ARM_MATH_LOOPUNROLL)
 
   /* Loop unrolling: Compute 4 outputs at a time */
   blkCnt = blockSize >> 2U;
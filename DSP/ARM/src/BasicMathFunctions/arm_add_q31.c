@@ -58,7 +58,58 @@ void arm_add_q31(
 {
         uint32_t blkCnt;                               /* Loop counter */
 
-#if defined (ARM_MATH_LOOPUNROLL)
+#if defined (ARM_MATH_X86_SSE2)
+
+#if defined (ARM_MATH_X86_AVX2)
+
+  /* Compute 8 outputs at a time */
+  blkCnt = blockSize >> 3U;
+
+  while (blkCnt > 0U)
+  {
+    /* C = A + B (saturated) */
+    __m256i a = _mm256_loadu_si256((const __m256i *) pSrcA);
+    __m256i b = _mm256_loadu_si256((const __m256i *) pSrcB);
+
+    _mm256_storeu_si256((__m256i *) pDst, x86_qadd_q31_256(a, b));
+
+    /* Increment pointers */
+    pSrcA += 8;
+    pSrcB += 8;
+    pDst += 8;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0x7U) >> 2U;
+#else
+  /* Compute 4 outputs at a time */
+  blkCnt = blockSize >> 2U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* C = A + B (saturated) */
+    __m128i a = _mm_loadu_si128((const __m128i *) pSrcA);
+    __m128i b = _mm_loadu_si128((const __m128i *) pSrcB);
+
+    _mm_storeu_si128((__m128i *) pDst, x86_qadd_q31(a, b));
+
+    /* Increment pointers */
+    pSrcA += 4;
+    pSrcB += 4;
+    pDst += 4;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Tail */
+  blkCnt = blockSize & 0x3U;
+
+#elif defined (ARM_MATH_LOOPUNROLL)
 
   /* Loop unrolling: Compute 4 outputs at a time */
   blkCnt = blockSize >> 2U;
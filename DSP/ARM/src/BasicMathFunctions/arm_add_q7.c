@@ -58,7 +58,58 @@ void arm_add_q7(
 {
         uint32_t blkCnt;                               /* Loop counter */
 
-#if defined (ARM_MATH_LOOPUNROLL)
+#if defined (ARM_MATH_X86_SSE2)
+
+#if defined (ARM_MATH_X86_AVX2)
+
+  /* Compute 32 outputs at a time */
+  blkCnt = blockSize >> 5U;
+
+  while (blkCnt > 0U)
+  {
+    /* C = A + B (saturated) */
+    __m256i a = _mm256_loadu_si256((const __m256i *) pSrcA);
+    __m256i b = _mm256_loadu_si256((const __m256i *) pSrcB);
+
+    _mm256_storeu_si256((__m256i *) pDst, _mm256_adds_epi8(a, b));
+
+    /* Increment pointers */
+    pSrcA += 32;
+    pSrcB += 32;
+    pDst += 32;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0x1FU) >> 4U;
+#else
+  /* Compute 16 outputs at a time */
+  blkCnt = blockSize >> 4U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* C = A + B (saturated) */
+    __m128i a = _mm_loadu_si128((const __m128i *) pSrcA);
+    __m128i b = _mm_loadu_si128((const __m128i *) pSrcB);
+
+    _mm_storeu_si128((__m128i *) pDst, _mm_adds_epi8(a, b));
+
+    /* Increment pointers */
+    pSrcA += 16;
+    pSrcB += 16;
+    pDst += 16;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Tail */
+  blkCnt = blockSize & 0xFU;
+
+#elif defined (ARM_MATH_LOOPUNROLL)
 
   /* Loop unrolling: Compute 4 outputs at a time */
   blkCnt = blockSize >> 2U;
@@ -28,6 +28,9 @@
 
 #include "arm_math.h"
 
+/* With ARM_MATH_X86_DISPATCH this function is built by the x86 dispatch layer (DispatchFunctions) */
+#if !defined(ARM_MATH_X86_DISPATCH) || defined(ARM_MATH_X86_DISPATCH_VARIANT)
+
 /**
   @ingroup groupMath
  */
@@ -107,6 +110,59 @@ void arm_dot_prod_f32(
     /* Tail */
     blkCnt = blockSize & 0x3;
 
+#elif defined (ARM_MATH_X86_SSE2)
+
+  __m128 acc128 = _mm_setzero_ps();
+
+#if defined (ARM_MATH_X86_AVX2)
+  __m256 acc256 = _mm256_setzero_ps();
+
+  /* Compute 8 outputs at a time */
+  blkCnt = blockSize >> 3U;
+
+  while (blkCnt > 0U)
+  {
+    /* 4 (8) partial sums, added in a different order than the scalar loop */
+    acc256 = _mm256_add_ps(acc256, _mm256_mul_ps(_mm256_loadu_ps(pSrcA), _mm256_loadu_ps(pSrcB)));
+
+    /* Increment pointers */
+    pSrcA += 8;
+    pSrcB += 8;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  acc128 = _mm_add_ps(_mm256_castps256_ps128(acc256), _mm256_extractf128_ps(acc256, 1));
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0x7U) >> 2U;
+#else
+  /* Compute 4 outputs at a time */
+  blkCnt = blockSize >> 2U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* 4 (8) partial sums, added in a different order than the scalar loop */
+    acc128 = _mm_add_ps(acc128, _mm_mul_ps(_mm_loadu_ps(pSrcA), _mm_loadu_ps(pSrcB)));
+
+    /* Increment pointers */
+    pSrcA += 4;
+    pSrcB += 4;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Horizontal sum */
+  acc128 = _mm_add_ps(acc128, _mm_movehl_ps(acc128, acc128));
+  acc128 = _mm_add_ss(acc128, _mm_shuffle_ps(acc128, acc128, _MM_SHUFFLE(1, 1, 1, 1)));
+  sum = _mm_cvtss_f32(acc128);
+
+  /* Tail */
+  blkCnt = blockSize & 0x3U;
+
 #else
 #if defined (ARM_MATH_LOOPUNROLL)
 
@@ -161,3 +217,5 @@ void arm_dot_prod_f32(
 /**
   @} end of BasicDotProd group
  */
+
+#endif /* #if !defined(ARM_MATH_X86_DISPATCH) || defined(ARM_MATH_X86_DISPATCH_VARIANT) */
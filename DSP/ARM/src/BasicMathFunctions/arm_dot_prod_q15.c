@@ -28,6 +28,9 @@
 
 #include "arm_math.h"
 
+/* With ARM_MATH_X86_DISPATCH this function is built by the x86 dispatch layer (DispatchFunctions) */
+#if !defined(ARM_MATH_X86_DISPATCH) || defined(ARM_MATH_X86_DISPATCH_VARIANT)
+
 /**
   @ingroup groupMath
  */
@@ -62,7 +65,72 @@ void arm_dot_prod_q15(
         uint32_t blkCnt;                               /* Loop counter */
         q63_t sum = 0;                                 /* Temporary return variable */
 
-#if defined (ARM_MATH_LOOPUNROLL)
+#if defined (ARM_MATH_X86_SSE2)
+
+  __m128i acc128 = _mm_setzero_si128();
+  const __m128i one128 = _mm_set1_epi32(1);
+  q63_t lanes[2];
+
+#if defined (ARM_MATH_X86_AVX2)
+  const __m256i one256 = _mm256_set1_epi32(1);
+  __m256i acc256 = _mm256_setzero_si256();
+
+  /* Compute 16 outputs at a time */
+  blkCnt = blockSize >> 4U;
+
+  while (blkCnt > 0U)
+  {
+    /* pairs of products minus one fit in 32 bits (2 * 0x8000 * 0x8000 does not), the ones are added back at the end */
+    __m256i a = _mm256_loadu_si256((const __m256i *) pSrcA);
+    __m256i b = _mm256_loadu_si256((const __m256i *) pSrcB);
+    __m256i p = _mm256_sub_epi32(_mm256_madd_epi16(a, b), one256);
+
+    acc256 = _mm256_add_epi64(acc256, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(p)));
+    acc256 = _mm256_add_epi64(acc256, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(p, 1)));
+
+    /* Increment pointers */
+    pSrcA += 16;
+    pSrcB += 16;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  acc128 = _mm_add_epi64(_mm256_castsi256_si128(acc256), _mm256_extracti128_si256(acc256, 1));
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0xFU) >> 3U;
+#else
+  /* Compute 8 outputs at a time */
+  blkCnt = blockSize >> 3U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* pairs of products minus one fit in 32 bits (2 * 0x8000 * 0x8000 does not), the ones are added back at the end */
+    __m128i a = _mm_loadu_si128((const __m128i *) pSrcA);
+    __m128i b = _mm_loadu_si128((const __m128i *) pSrcB);
+    __m128i p = _mm_sub_epi32(_mm_madd_epi16(a, b), one128);
+
+    acc128 = _mm_add_epi64(acc128, x86_cvtlo_q31_q63(p));
+    acc128 = _mm_add_epi64(acc128, x86_cvthi_q31_q63(p));
+
+    /* Increment pointers */
+    pSrcA += 8;
+    pSrcB += 8;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Horizontal sum, plus one per pair of products */
+  _mm_storeu_si128((__m128i *) lanes, acc128);
+  sum = lanes[0] + lanes[1] + (q63_t) ((blockSize & ~0x7U) >> 1U);
+
+  /* Tail */
+  blkCnt = blockSize & 0x7U;
+
+#elif defined (ARM_MATH_LOOPUNROLL)
 
   /* Loop unrolling: Compute 4 outputs at a time */
   blkCnt = blockSize >> 2U;
@@ -118,3 +186,5 @@ void arm_dot_prod_q15(
 /**
   @} end of BasicDotProd group
  */
+
+#endif /* #if !defined(ARM_MATH_X86_DISPATCH) || defined(ARM_MATH_X86_DISPATCH_VARIANT) */
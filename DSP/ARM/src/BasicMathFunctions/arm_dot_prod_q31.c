@@ -28,6 +28,9 @@
 
 #include "arm_math.h"
 
+/* With ARM_MATH_X86_DISPATCH this function is built by the x86 dispatch layer (DispatchFunctions) */
+#if !defined(ARM_MATH_X86_DISPATCH) || defined(ARM_MATH_X86_DISPATCH_VARIANT)
+
 /**
   @ingroup groupMath
  */
@@ -63,7 +66,72 @@ void arm_dot_prod_q31(
         uint32_t blkCnt;                               /* Loop counter */
         q63_t sum = 0;                                 /* Temporary return variable */
 
-#if defined (ARM_MATH_LOOPUNROLL)
+#if defined (ARM_MATH_X86_SSE2) && defined (__SSE4_1__)
+
+  __m128i acc128 = _mm_setzero_si128();
+  q63_t lanes[2];
+
+#if defined (ARM_MATH_X86_AVX2)
+  __m256i acc256 = _mm256_setzero_si256();
+
+  /* Compute 8 outputs at a time */
+  blkCnt = blockSize >> 3U;
+
+  while (blkCnt > 0U)
+  {
+    /* 64-bit products of the even and odd lanes */
+    __m256i a = _mm256_loadu_si256((const __m256i *) pSrcA);
+    __m256i b = _mm256_loadu_si256((const __m256i *) pSrcB);
+    __m256i even = _mm256_mul_epi32(a, b);
+    __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+
+    acc256 = _mm256_add_epi64(acc256, x86_srai_q63_256(even, 14));
+    acc256 = _mm256_add_epi64(acc256, x86_srai_q63_256(odd, 14));
+
+    /* Increment pointers */
+    pSrcA += 8;
+    pSrcB += 8;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  acc128 = _mm_add_epi64(_mm256_castsi256_si128(acc256), _mm256_extracti128_si256(acc256, 1));
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0x7U) >> 2U;
+#else
+  /* Compute 4 outputs at a time */
+  blkCnt = blockSize >> 2U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* 64-bit products of the even and odd lanes */
+    __m128i a = _mm_loadu_si128((const __m128i *) pSrcA);
+    __m128i b = _mm_loadu_si128((const __m128i *) pSrcB);
+    __m128i even = _mm_mul_epi32(a, b);
+    __m128i odd = _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+    acc128 = _mm_add_epi64(acc128, x86_srai_q63(even, 14));
+    acc128 = _mm_add_epi64(acc128, x86_srai_q63(odd, 14));
+
+    /* Increment pointers */
+    pSrcA += 4;
+    pSrcB += 4;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Horizontal sum */
+  _mm_storeu_si128((__m128i *) lanes, acc128);
+  sum = lanes[0] + lanes[1];
+
+  /* Tail */
+  blkCnt = blockSize & 0x3U;
+
+#elif defined (ARM_MATH_LOOPUNROLL)
 
   /* Loop unrolling: Compute 4 outputs at a time */
   blkCnt = blockSize >> 2U;
@@ -113,3 +181,5 @@ void arm_dot_prod_q31(
 /**
   @} end of BasicDotProd group
  */
+
+#endif /* #if !defined(ARM_MATH_X86_DISPATCH) || defined(ARM_MATH_X86_DISPATCH_VARIANT) */
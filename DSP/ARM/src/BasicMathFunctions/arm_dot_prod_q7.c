@@ -28,6 +28,9 @@
 
 #include "arm_math.h"
 
+/* With ARM_MATH_X86_DISPATCH this function is built by the x86 dispatch layer (DispatchFunctions) */
+#if !defined(ARM_MATH_X86_DISPATCH) || defined(ARM_MATH_X86_DISPATCH_VARIANT)
+
 /**
   @ingroup groupMath
  */
@@ -62,7 +65,70 @@ void arm_dot_prod_q7(
         uint32_t blkCnt;                               /* Loop counter */
         q31_t sum = 0;                                 /* Temporary return variable */
 
-#if defined (ARM_MATH_LOOPUNROLL)
+#if defined (ARM_MATH_X86_SSE2)
+
+  __m128i acc128 = _mm_setzero_si128();
+
+#if defined (ARM_MATH_X86_AVX2)
+  __m256i acc256 = _mm256_setzero_si256();
+
+  /* Compute 32 outputs at a time */
+  blkCnt = blockSize >> 5U;
+
+  while (blkCnt > 0U)
+  {
+    /* q15 products summed by pairs in 32-bit lanes (wraps like the scalar q31 sum) */
+    __m256i a = _mm256_loadu_si256((const __m256i *) pSrcA);
+    __m256i b = _mm256_loadu_si256((const __m256i *) pSrcB);
+    __m256i lo = _mm256_madd_epi16(_mm256_srai_epi16(_mm256_unpacklo_epi8(a, a), 8), _mm256_srai_epi16(_mm256_unpacklo_epi8(b, b), 8));
+    __m256i hi = _mm256_madd_epi16(_mm256_srai_epi16(_mm256_unpackhi_epi8(a, a), 8), _mm256_srai_epi16(_mm256_unpackhi_epi8(b, b), 8));
+
+    acc256 = _mm256_add_epi32(acc256, _mm256_add_epi32(lo, hi));
+
+    /* Increment pointers */
+    pSrcA += 32;
+    pSrcB += 32;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  acc128 = _mm_add_epi32(_mm256_castsi256_si128(acc256), _mm256_extracti128_si256(acc256, 1));
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0x1FU) >> 4U;
+#else
+  /* Compute 16 outputs at a time */
+  blkCnt = blockSize >> 4U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* q15 products summed by pairs in 32-bit lanes (wraps like the scalar q31 sum) */
+    __m128i a = _mm_loadu_si128((const __m128i *) pSrcA);
+    __m128i b = _mm_loadu_si128((const __m128i *) pSrcB);
+    __m128i lo = _mm_madd_epi16(x86_cvtlo_q7_q15(a), x86_cvtlo_q7_q15(b));
+    __m128i hi = _mm_madd_epi16(x86_cvthi_q7_q15(a), x86_cvthi_q7_q15(b));
+
+    acc128 = _mm_add_epi32(acc128, _mm_add_epi32(lo, hi));
+
+    /* Increment pointers */
+    pSrcA += 16;
+    pSrcB += 16;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Horizontal sum */
+  acc128 = _mm_add_epi32(acc128, _mm_shuffle_epi32(acc128, _MM_SHUFFLE(1, 0, 3, 2)));
+  acc128 = _mm_add_epi32(acc128, _mm_shuffle_epi32(acc128, _MM_SHUFFLE(2, 3, 0, 1)));
+  sum = _mm_cvtsi128_si32(acc128);
+
+  /* Tail */
+  blkCnt = blockSize & 0xFU;
+
+#elif defined (ARM_MATH_LOOPUNROLL)
 
 #if defined (ARM_MATH_DSP)
   q31_t input1, input2;                          /* Temporary variables */
@@ -137,3 +203,5 @@ void arm_dot_prod_q7(
 /**
   @} end of BasicDotProd group
  */
+
+#endif /* #if !defined(ARM_MATH_X86_DISPATCH) || defined(ARM_MATH_X86_DISPATCH_VARIANT) */
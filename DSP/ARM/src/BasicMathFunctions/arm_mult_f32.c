@@ -96,6 +96,51 @@ void arm_mult_f32(
     /* Tail */
     blkCnt = blockSize & 0x3;
 
+#elif defined (ARM_MATH_X86_SSE2)
+
+#if defined (ARM_MATH_X86_AVX2)
+
+  /* Compute 8 outputs at a time */
+  blkCnt = blockSize >> 3U;
+
+  while (blkCnt > 0U)
+  {
+    /* C = A * B */
+    _mm256_storeu_ps(pDst, _mm256_mul_ps(_mm256_loadu_ps(pSrcA), _mm256_loadu_ps(pSrcB)));
+
+    /* Increment pointers */
+    pSrcA += 8;
+    pSrcB += 8;
+    pDst += 8;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0x7U) >> 2U;
+#else
+  /* Compute 4 outputs at a time */
+  blkCnt = blockSize >> 2U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* C = A * B */
+    _mm_storeu_ps(pDst, _mm_mul_ps(_mm_loadu_ps(pSrcA), _mm_loadu_ps(pSrcB)));
+
+    /* Increment pointers */
+    pSrcA += 4;
+    pSrcB += 4;
+    pDst += 4;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Tail */
+  blkCnt = blockSize & 0x3U;
+
 #else
 #if defined (ARM_MATH_LOOPUNROLL)
 
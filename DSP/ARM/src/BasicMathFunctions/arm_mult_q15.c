@@ -58,7 +58,66 @@ void arm_mult_q15(
 {
         uint32_t blkCnt;                               /* Loop counter */
 
-#if defined (ARM_MATH_LOOPUNROLL)
+#if defined (ARM_MATH_X86_SSE2)
+
+#if defined (ARM_MATH_X86_AVX2)
+
+  /* Compute 16 outputs at a time */
+  blkCnt = blockSize >> 4U;
+
+  while (blkCnt > 0U)
+  {
+    /* C = A * B, 32-bit products shifted back to q15 (saturated) */
+    __m256i a = _mm256_loadu_si256((const __m256i *) pSrcA);
+    __m256i b = _mm256_loadu_si256((const __m256i *) pSrcB);
+    __m256i lo = _mm256_mullo_epi16(a, b);
+    __m256i hi = _mm256_mulhi_epi16(a, b);
+    __m256i p0 = _mm256_srai_epi32(_mm256_unpacklo_epi16(lo, hi), 15);
+    __m256i p1 = _mm256_srai_epi32(_mm256_unpackhi_epi16(lo, hi), 15);
+
+    _mm256_storeu_si256((__m256i *) pDst, _mm256_packs_epi32(p0, p1));
+
+    /* Increment pointers */
+    pSrcA += 16;
+    pSrcB += 16;
+    pDst += 16;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0xFU) >> 3U;
+#else
+  /* Compute 8 outputs at a time */
+  blkCnt = blockSize >> 3U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* C = A * B, 32-bit products shifted back to q15 (saturated) */
+    __m128i a = _mm_loadu_si128((const __m128i *) pSrcA);
+    __m128i b = _mm_loadu_si128((const __m128i *) pSrcB);
+    __m128i lo = _mm_mullo_epi16(a, b);
+    __m128i hi = _mm_mulhi_epi16(a, b);
+    __m128i p0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+    __m128i p1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+
+    _mm_storeu_si128((__m128i *) pDst, _mm_packs_epi32(p0, p1));
+
+    /* Increment pointers */
+    pSrcA += 8;
+    pSrcB += 8;
+    pDst += 8;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Tail */
+  blkCnt = blockSize & 0x7U;
+
+#elif defined (ARM_MATH_LOOPUNROLL)
 
 #if defined (ARM_MATH_DSP)
   q31_t inA1, inA2, inB1, inB2;                  /* Temporary input variables */
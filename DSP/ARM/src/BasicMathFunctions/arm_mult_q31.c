@@ -59,7 +59,63 @@ void arm_mult_q31(
         uint32_t blkCnt;                               /* Loop counter */
         q31_t out;                                     /* Temporary output variable */
 
-#if defined (ARM_MATH_LOOPUNROLL)
+#if defined (ARM_MATH_X86_SSE2) && defined (__SSE4_1__)
+
+  const __m128i max128 = _mm_set1_epi32(0x3FFFFFFF);
+
+#if defined (ARM_MATH_X86_AVX2)
+  const __m256i max256 = _mm256_set1_epi32(0x3FFFFFFF);
+
+  /* Compute 8 outputs at a time */
+  blkCnt = blockSize >> 3U;
+
+  while (blkCnt > 0U)
+  {
+    /* C = A * B, only 0x80000000 * 0x80000000 saturates (0x3FFFFFFF before the shift) */
+    __m256i a = _mm256_loadu_si256((const __m256i *) pSrcA);
+    __m256i b = _mm256_loadu_si256((const __m256i *) pSrcB);
+    __m256i hi = _mm256_min_epi32(x86_mulhi_q31_256(a, b), max256);
+
+    _mm256_storeu_si256((__m256i *) pDst, _mm256_slli_epi32(hi, 1));
+
+    /* Increment pointers */
+    pSrcA += 8;
+    pSrcB += 8;
+    pDst += 8;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0x7U) >> 2U;
+#else
+  /* Compute 4 outputs at a time */
+  blkCnt = blockSize >> 2U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* C = A * B, only 0x80000000 * 0x80000000 saturates (0x3FFFFFFF before the shift) */
+    __m128i a = _mm_loadu_si128((const __m128i *) pSrcA);
+    __m128i b = _mm_loadu_si128((const __m128i *) pSrcB);
+    __m128i hi = _mm_min_epi32(x86_mulhi_q31(a, b), max128);
+
+    _mm_storeu_si128((__m128i *) pDst, _mm_slli_epi32(hi, 1));
+
+    /* Increment pointers */
+    pSrcA += 4;
+    pSrcB += 4;
+    pDst += 4;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Tail */
+  blkCnt = blockSize & 0x3U;
+
+#elif defined (ARM_MATH_LOOPUNROLL)
 
   /* Loop unrolling: Compute 4 outputs at a time */
   blkCnt = blockSize >> 2U;
@@ -58,7 +58,63 @@ void arm_mult_q7(
 {
         uint32_t blkCnt;                               /* Loop counter */
 
-#if defined (ARM_MATH_LOOPUNROLL)
+#if defined (ARM_MATH_X86_SSE2)
+
+#if defined (ARM_MATH_X86_AVX2)
+
+  /* Compute 32 outputs at a time */
+  blkCnt = blockSize >> 5U;
+
+  while (blkCnt > 0U)
+  {
+    /* C = A * B, products in q15 then shifted back to q7 (saturated) */
+    __m256i a = _mm256_loadu_si256((const __m256i *) pSrcA);
+    __m256i b = _mm256_loadu_si256((const __m256i *) pSrcB);
+    __m256i lo = _mm256_mullo_epi16(_mm256_srai_epi16(_mm256_unpacklo_epi8(a, a), 8), _mm256_srai_epi16(_mm256_unpacklo_epi8(b, b), 8));
+    __m256i hi = _mm256_mullo_epi16(_mm256_srai_epi16(_mm256_unpackhi_epi8(a, a), 8), _mm256_srai_epi16(_mm256_unpackhi_epi8(b, b), 8));
+
+    /* the unpack and the pack both work within the 128-bit lanes, the order is kept */
+    _mm256_storeu_si256((__m256i *) pDst, _mm256_packs_epi16(_mm256_srai_epi16(lo, 7), _mm256_srai_epi16(hi, 7)));
+
+    /* Increment pointers */
+    pSrcA += 32;
+    pSrcB += 32;
+    pDst += 32;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0x1FU) >> 4U;
+#else
+  /* Compute 16 outputs at a time */
+  blkCnt = blockSize >> 4U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* C = A * B, products in q15 then shifted back to q7 (saturated) */
+    __m128i a = _mm_loadu_si128((const __m128i *) pSrcA);
+    __m128i b = _mm_loadu_si128((const __m128i *) pSrcB);
+    __m128i lo = _mm_mullo_epi16(x86_cvtlo_q7_q15(a), x86_cvtlo_q7_q15(b));
+    __m128i hi = _mm_mullo_epi16(x86_cvthi_q7_q15(a), x86_cvthi_q7_q15(b));
+
+    _mm_storeu_si128((__m128i *) pDst, _mm_packs_epi16(_mm_srai_epi16(lo, 7), _mm_srai_epi16(hi, 7)));
+
+    /* Increment pointers */
+    pSrcA += 16;
+    pSrcB += 16;
+    pDst += 16;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Tail */
+  blkCnt = blockSize & 0xFU;
+
+#elif defined (ARM_MATH_LOOPUNROLL)
 
 #if defined (ARM_MATH_DSP)
   q7_t out1, out2, out3, out4;                   /* Temporary output variables */
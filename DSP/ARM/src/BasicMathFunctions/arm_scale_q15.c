@@ -69,7 +69,67 @@ void arm_scale_q15(
 #endif
 #endif
 
-#if defined (ARM_MATH_LOOPUNROLL)
+#if defined (ARM_MATH_X86_SSE2)
+
+  const __m128i count = _mm_cvtsi32_si128(kShift);
+
+  const __m128i scale128 = _mm_set1_epi16(scaleFract);
+
+#if defined (ARM_MATH_X86_AVX2)
+  const __m256i scale256 = _mm256_set1_epi16(scaleFract);
+
+  /* Compute 16 outputs at a time */
+  blkCnt = blockSize >> 4U;
+
+  while (blkCnt > 0U)
+  {
+    /* C = A * scale, 32-bit products shifted back to q15 (saturated) */
+    __m256i a = _mm256_loadu_si256((const __m256i *) pSrc);
+    __m256i lo = _mm256_mullo_epi16(a, scale256);
+    __m256i hi = _mm256_mulhi_epi16(a, scale256);
+    __m256i p0 = _mm256_sra_epi32(_mm256_unpacklo_epi16(lo, hi), count);
+    __m256i p1 = _mm256_sra_epi32(_mm256_unpackhi_epi16(lo, hi), count);
+
+    _mm256_storeu_si256((__m256i *) pDst, _mm256_packs_epi32(p0, p1));
+
+    /* Increment pointers */
+    pSrc += 16;
+    pDst += 16;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0xFU) >> 3U;
+#else
+  /* Compute 8 outputs at a time */
+  blkCnt = blockSize >> 3U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* C = A * scale, 32-bit products shifted back to q15 (saturated) */
+    __m128i a = _mm_loadu_si128((const __m128i *) pSrc);
+    __m128i lo = _mm_mullo_epi16(a, scale128);
+    __m128i hi = _mm_mulhi_epi16(a, scale128);
+    __m128i p0 = _mm_sra_epi32(_mm_unpacklo_epi16(lo, hi), count);
+    __m128i p1 = _mm_sra_epi32(_mm_unpackhi_epi16(lo, hi), count);
+
+    _mm_storeu_si128((__m128i *) pDst, _mm_packs_epi32(p0, p1));
+
+    /* Increment pointers */
+    pSrc += 8;
+    pDst += 8;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Tail */
+  blkCnt = blockSize & 0x7U;
+
+#elif defined (ARM_MATH_LOOPUNROLL)
 
   /* Loop unrolling: Compute 4 outputs at a time */
   blkCnt = blockSize >> 2U;
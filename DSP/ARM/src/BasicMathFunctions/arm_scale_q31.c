@@ -63,7 +63,91 @@ void arm_scale_q31(
         int8_t kShift = shift + 1;                     /* Shift to apply after scaling */
         int8_t sign = (kShift & 0x80);
 
-#if defined (ARM_MATH_LOOPUNROLL)
+#if defined (ARM_MATH_X86_SSE2) && defined (__SSE4_1__)
+
+  const __m128i count = _mm_cvtsi32_si128((sign == 0U) ? kShift : -kShift);
+
+  const __m128i scale128 = _mm_set1_epi32(scaleFract);
+  const __m128i max128 = _mm_set1_epi32(0x7FFFFFFF);
+
+#if defined (ARM_MATH_X86_AVX2)
+  const __m256i scale256 = _mm256_set1_epi32(scaleFract);
+  const __m256i max256 = _mm256_set1_epi32(0x7FFFFFFF);
+
+  /* Compute 8 outputs at a time */
+  blkCnt = blockSize >> 3U;
+
+  while (blkCnt > 0U)
+  {
+    /* C = A * scale, left shifts saturate on overflow */
+    __m256i a = _mm256_loadu_si256((const __m256i *) pSrc);
+    __m256i hi = x86_mulhi_q31_256(a, scale256);
+    __m256i r;
+
+    if (sign == 0U)
+    {
+      /* overflow when shifting back does not give the input */
+      __m256i ovf;
+      r = _mm256_sll_epi32(hi, count);
+      ovf = _mm256_cmpeq_epi32(_mm256_sra_epi32(r, count), hi);
+      r = _mm256_blendv_epi8(_mm256_xor_si256(max256, _mm256_srai_epi32(hi, 31)), r, ovf);
+    }
+    else
+    {
+      r = _mm256_sra_epi32(hi, count);
+    }
+
+    _mm256_storeu_si256((__m256i *) pDst, r);
+
+    /* Increment pointers */
+    pSrc += 8;
+    pDst += 8;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0x7U) >> 2U;
+#else
+  /* Compute 4 outputs at a time */
+  blkCnt = blockSize >> 2U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* C = A * scale, left shifts saturate on overflow */
+    __m128i a = _mm_loadu_si128((const __m128i *) pSrc);
+    __m128i hi = x86_mulhi_q31(a, scale128);
+    __m128i r;
+
+    if (sign == 0U)
+    {
+      /* overflow when shifting back does not give the input */
+      __m128i ovf;
+      r = _mm_sll_epi32(hi, count);
+      ovf = _mm_cmpeq_epi32(_mm_sra_epi32(r, count), hi);
+      r = _mm_blendv_epi8(_mm_xor_si128(max128, _mm_srai_epi32(hi, 31)), r, ovf);
+    }
+    else
+    {
+      r = _mm_sra_epi32(hi, count);
+    }
+
+    _mm_storeu_si128((__m128i *) pDst, r);
+
+    /* Increment pointers */
+    pSrc += 4;
+    pDst += 4;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Tail */
+  blkCnt = blockSize & 0x3U;
+
+#elif defined (ARM_MATH_LOOPUNROLL)
 
   /* Loop unrolling: Compute 4 outputs at a time */
   blkCnt = blockSize >> 2U;
@@ -61,7 +61,63 @@ void arm_scale_q7(
         uint32_t blkCnt;                               /* Loop counter */
         int8_t kShift = 7 - shift;                     /* Shift to apply after scaling */
 
-#if defined (ARM_MATH_LOOPUNROLL)
+#if defined (ARM_MATH_X86_SSE2)
+
+  const __m128i count = _mm_cvtsi32_si128(kShift);
+
+  const __m128i scale128 = _mm_set1_epi16(scaleFract);
+
+#if defined (ARM_MATH_X86_AVX2)
+  const __m256i scale256 = _mm256_set1_epi16(scaleFract);
+
+  /* Compute 32 outputs at a time */
+  blkCnt = blockSize >> 5U;
+
+  while (blkCnt > 0U)
+  {
+    /* C = A * scale, products in q15 shifted back to q7 (saturated) */
+    __m256i a = _mm256_loadu_si256((const __m256i *) pSrc);
+    __m256i lo = _mm256_sra_epi16(_mm256_mullo_epi16(_mm256_srai_epi16(_mm256_unpacklo_epi8(a, a), 8), scale256), count);
+    __m256i hi = _mm256_sra_epi16(_mm256_mullo_epi16(_mm256_srai_epi16(_mm256_unpackhi_epi8(a, a), 8), scale256), count);
+
+    _mm256_storeu_si256((__m256i *) pDst, _mm256_packs_epi16(lo, hi));
+
+    /* Increment pointers */
+    pSrc += 32;
+    pDst += 32;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* At most one iteration of the 128-bit loop */
+  blkCnt = (blockSize & 0x1FU) >> 4U;
+#else
+  /* Compute 16 outputs at a time */
+  blkCnt = blockSize >> 4U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    /* C = A * scale, products in q15 shifted back to q7 (saturated) */
+    __m128i a = _mm_loadu_si128((const __m128i *) pSrc);
+    __m128i lo = _mm_sra_epi16(_mm_mullo_epi16(x86_cvtlo_q7_q15(a), scale128), count);
+    __m128i hi = _mm_sra_epi16(_mm_mullo_epi16(x86_cvthi_q7_q15(a), scale128), count);
+
+    _mm_storeu_si128((__m128i *) pDst, _mm_packs_epi16(lo, hi));
+
+    /* Increment pointers */
+    pSrc += 16;
+    pDst += 16;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Tail */
+  blkCnt = blockSize & 0xFU;
+
+#elif defined (ARM_MATH_LOOPUNROLL)
 
 #if defined (ARM_MATH_DSP)
   q7_t in1,  in2,  in3,  in4;                    /* Temporary input variables */
@@ -0,0 +1,183 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_dispatch_x86.c
+ * Description:  Processor detection and binding of the x86 versions
+ *
+ * Target Processor: x86 hosts
+ * -------------------------------------------------------------------- */
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(ARM_MATH_X86_DISPATCH)
+
+#include "arm_dispatch_x86.h"
+#include "arm_dispatch_x86_kernels.h"
+#include <cpuid.h>
+#include <stdatomic.h>
+
+/* Versions built by arm_dispatch_x86_<isa>.c */
+#define ARM_DISPATCH_X86_DECLARE(ret, name, params) \
+  ret name##_sse2 params;                             \
+  ret name##_sse41 params;                            \
+  ret name##_avx2 params;                             \
+  ret name##_avx512 params;
+#define ARM_DISPATCH_X86_DECLARE_V(name, params, args) ARM_DISPATCH_X86_DECLARE(void, name, params)
+#define ARM_DISPATCH_X86_DECLARE_S(name, params, args) ARM_DISPATCH_X86_DECLARE(arm_status, name, params)
+ARM_DISPATCH_X86_KERNELS(ARM_DISPATCH_X86_DECLARE_V, ARM_DISPATCH_X86_DECLARE_S)
+
+typedef struct
+{
+#define ARM_DISPATCH_X86_FIELD_V(name, params, args) void (*name) params;
+#define ARM_DISPATCH_X86_FIELD_S(name, params, args) arm_status (*name) params;
+  ARM_DISPATCH_X86_KERNELS(ARM_DISPATCH_X86_FIELD_V, ARM_DISPATCH_X86_FIELD_S)
+} arm_dispatch_x86_table;
+
+#define ARM_DISPATCH_X86_SSE2(name, params, args)   name##_sse2,
+#define ARM_DISPATCH_X86_SSE41(name, params, args)  name##_sse41,
+#define ARM_DISPATCH_X86_AVX2(name, params, args)   name##_avx2,
+#define ARM_DISPATCH_X86_AVX512(name, params, args) name##_avx512,
+
+static const arm_dispatch_x86_table arm_dispatch_x86_tables[ARM_X86_ISA_COUNT] =
+{
+  { ARM_DISPATCH_X86_KERNELS(ARM_DISPATCH_X86_SSE2, ARM_DISPATCH_X86_SSE2) },
+  { ARM_DISPATCH_X86_KERNELS(ARM_DISPATCH_X86_SSE41, ARM_DISPATCH_X86_SSE41) },
+  { ARM_DISPATCH_X86_KERNELS(ARM_DISPATCH_X86_AVX2, ARM_DISPATCH_X86_AVX2) },
+  { ARM_DISPATCH_X86_KERNELS(ARM_DISPATCH_X86_AVX512, ARM_DISPATCH_X86_AVX512) }
+};
+
+/*
+ * The binding is one atomic pointer to a constant table, so calls, the first binding and
+ * arm_dispatch_x86_select() can run on different threads. Until the first binding it points
+ * to a table of stubs that bind the best version and forward the call.
+ */
+static const arm_dispatch_x86_table arm_dispatch_x86_stubs;
+static _Atomic(const arm_dispatch_x86_table *) arm_dispatch_x86_bound = &arm_dispatch_x86_stubs;
+
+#define ARM_DISPATCH_X86_BOUND() atomic_load_explicit(&arm_dispatch_x86_bound, memory_order_acquire)
+
+#define ARM_DISPATCH_X86_RESOLVE_V(name, params, args) \
+  static void name##_resolve params                    \
+  {                                                    \
+    arm_dispatch_x86_init();                           \
+    ARM_DISPATCH_X86_BOUND()->name args;               \
+  }
+#define ARM_DISPATCH_X86_RESOLVE_S(name, params, args) \
+  static arm_status name##_resolve params              \
+  {                                                    \
+    arm_dispatch_x86_init();                           \
+    return ARM_DISPATCH_X86_BOUND()->name args;        \
+  }
+#define ARM_DISPATCH_X86_STUB(name, params, args) name##_resolve,
+
+ARM_DISPATCH_X86_KERNELS(ARM_DISPATCH_X86_RESOLVE_V, ARM_DISPATCH_X86_RESOLVE_S)
+
+static const arm_dispatch_x86_table arm_dispatch_x86_stubs =
+{
+  ARM_DISPATCH_X86_KERNELS(ARM_DISPATCH_X86_STUB, ARM_DISPATCH_X86_STUB)
+};
+
+/* Public functions: one atomic load (a plain load on x86) and one indirect call */
+#define ARM_DISPATCH_X86_PUBLIC_V(name, params, args) \
+  void name params                                    \
+  {                                                   \
+    ARM_DISPATCH_X86_BOUND()->name args;              \
+  }
+#define ARM_DISPATCH_X86_PUBLIC_S(name, params, args) \
+  arm_status name params                              \
+  {                                                   \
+    return ARM_DISPATCH_X86_BOUND()->name args;       \
+  }
+ARM_DISPATCH_X86_KERNELS(ARM_DISPATCH_X86_PUBLIC_V, ARM_DISPATCH_X86_PUBLIC_S)
+
+/* Register state enabled by the OS (XCR0) */
+static uint32_t arm_dispatch_x86_xcr0(void)
+{
+  uint32_t lo, hi;
+
+  __asm__ volatile ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+  (void) hi;
+  return lo;
+}
+
+arm_x86_isa arm_dispatch_x86_detect(void)
+{
+  unsigned int eax, ebx, ecx, edx;
+  unsigned int ebx7 = 0U;
+  uint32_t xcr0 = 0U;
+
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+    return ARM_X86_ISA_SSE2;
+
+  if ((ecx & bit_SSE4_1) == 0U)
+    return ARM_X86_ISA_SSE2;
+
+  /* AVX registers must be saved by the OS (OSXSAVE, then XMM and YMM state in XCR0) */
+  if ((ecx & bit_OSXSAVE) != 0U && (ecx & bit_AVX) != 0U)
+  {
+    xcr0 = arm_dispatch_x86_xcr0();
+  }
+
+  if (__get_cpuid_count(7, 0, &eax, &ebx7, &ecx, &edx) == 0 || (xcr0 & 0x06U) != 0x06U)
+    return ARM_X86_ISA_SSE41;
+
+  if ((ebx7 & bit_AVX2) == 0U)
+    return ARM_X86_ISA_SSE41;
+
+  /* AVX-512: opmask, upper halves of ZMM0-15 and ZMM16-31 state */
+  if ((ebx7 & (bit_AVX512F | bit_AVX512BW | bit_AVX512DQ | bit_AVX512VL)) == (bit_AVX512F | bit_AVX512BW | bit_AVX512DQ | bit_AVX512VL) &&
+      (xcr0 & 0xE0U) == 0xE0U)
+    return ARM_X86_ISA_AVX512;
+
+  return ARM_X86_ISA_AVX2;
+}
+
+arm_x86_isa arm_dispatch_x86_init(void)
+{
+  arm_x86_isa isa = arm_dispatch_x86_detect();
+
+  atomic_store_explicit(&arm_dispatch_x86_bound, &arm_dispatch_x86_tables[isa], memory_order_release);
+  return isa;
+}
+
+arm_status arm_dispatch_x86_select(
+  arm_x86_isa isa)
+{
+  if ((uint32_t) isa >= (uint32_t) ARM_X86_ISA_COUNT || isa > arm_dispatch_x86_detect())
+    return ARM_MATH_ARGUMENT_ERROR;
+
+  atomic_store_explicit(&arm_dispatch_x86_bound, &arm_dispatch_x86_tables[isa], memory_order_release);
+  return ARM_MATH_SUCCESS;
+}
+
+arm_x86_isa arm_dispatch_x86_current(void)
+{
+  const arm_dispatch_x86_table * bound = ARM_DISPATCH_X86_BOUND();
+
+  if (bound == &arm_dispatch_x86_stubs)
+    return arm_dispatch_x86_init();
+
+  return (arm_x86_isa) (bound - arm_dispatch_x86_tables);
+}
+
+const char * arm_dispatch_x86_name(
+  arm_x86_isa isa)
+{
+  static const char * const names[ARM_X86_ISA_COUNT] = { "sse2", "sse4.1", "avx2", "avx512" };
+
+  return ((uint32_t) isa < (uint32_t) ARM_X86_ISA_COUNT) ? names[isa] : "unknown";
+}
+
+#endif /* #if defined(ARM_MATH_X86_DISPATCH) */
@@ -0,0 +1,41 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_dispatch_x86_avx2.c
+ * Description:  AVX2 version of the dispatched functions
+ *
+ * Target Processor: x86 hosts
+ * -------------------------------------------------------------------- */
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(ARM_MATH_X86_DISPATCH)
+
+#if !defined(__GNUC__) || defined(__clang__)
+  #error "the x86 dispatch layer needs GCC (#pragma GCC target)"
+#endif
+
+#pragma GCC target("avx2")
+
+#undef  ARM_MATH_X86_SSE2
+#undef  ARM_MATH_X86_AVX2
+#define ARM_MATH_X86_AVX2
+#define ARM_MATH_X86_DISPATCH_VARIANT
+#define ARM_DISPATCH_X86_SUFFIX _avx2
+
+#include "arm_math.h"
+#include "arm_dispatch_x86_variant.h"
+
+#endif /* #if defined(ARM_MATH_X86_DISPATCH) */
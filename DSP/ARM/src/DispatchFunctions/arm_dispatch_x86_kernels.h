@@ -0,0 +1,41 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_dispatch_x86_kernels.h
+ * Description:  Functions bound at run time by the x86 dispatch layer
+ *
+ * Target Processor: x86 hosts
+ * -------------------------------------------------------------------- */
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ARM_DISPATCH_X86_KERNELS_H
+#define _ARM_DISPATCH_X86_KERNELS_H
+
+/*
+ * XV(name, parameters, arguments) for the functions returning void,
+ * XS(name, parameters, arguments) for the ones returning arm_status.
+ * Only the functions with x86 intrinsic versions are listed (ARM_MATH_X86_SSE2/AVX2 paths
+ * that gain from a wider instruction set), the others are called directly.
+ * A function added here must also be renamed and included in arm_dispatch_x86_variant.h,
+ * and its source must be guarded by ARM_MATH_X86_DISPATCH.
+ */
+#define ARM_DISPATCH_X86_KERNELS(XV, XS) \
+  XV(arm_dot_prod_f32, (const float32_t * pSrcA, const float32_t * pSrcB, uint32_t blockSize, float32_t * result), (pSrcA, pSrcB, blockSize, result)) \
+  XV(arm_dot_prod_q31, (const q31_t * pSrcA, const q31_t * pSrcB, uint32_t blockSize, q63_t * result), (pSrcA, pSrcB, blockSize, result)) \
+  XV(arm_dot_prod_q15, (const q15_t * pSrcA, const q15_t * pSrcB, uint32_t blockSize, q63_t * result), (pSrcA, pSrcB, blockSize, result)) \
+  XV(arm_dot_prod_q7, (const q7_t * pSrcA, const q7_t * pSrcB, uint32_t blockSize, q31_t * result), (pSrcA, pSrcB, blockSize, result))
+
+#endif /* _ARM_DISPATCH_X86_KERNELS_H */
@@ -0,0 +1,49 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_dispatch_x86_variant.h
+ * Description:  Builds one x86 version of the dispatched functions
+ *
+ * Target Processor: x86 hosts
+ * -------------------------------------------------------------------- */
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Included once by each arm_dispatch_x86_<isa>.c, after arm_math.h, with the target set
+ * and ARM_DISPATCH_X86_SUFFIX defined: the sources of the functions are compiled again
+ * with their names suffixed (arm_dot_prod_f32_avx2...).
+ */
+
+#if !defined(ARM_DISPATCH_X86_SUFFIX)
+  #error "define ARM_DISPATCH_X86_SUFFIX before including arm_dispatch_x86_variant.h"
+#endif
+
+/* AVX-512F has FMA instructions: no contraction, the results must not depend on the version */
+#pragma GCC optimize ("fp-contract=off")
+
+#define ARM_DISPATCH_X86_CAT_(a, b) a##b
+#define ARM_DISPATCH_X86_CAT(a, b)  ARM_DISPATCH_X86_CAT_(a, b)
+#define ARM_DISPATCH_X86_NAME(name) ARM_DISPATCH_X86_CAT(name, ARM_DISPATCH_X86_SUFFIX)
+
+#define arm_dot_prod_f32   ARM_DISPATCH_X86_NAME(arm_dot_prod_f32)
+#define arm_dot_prod_q31   ARM_DISPATCH_X86_NAME(arm_dot_prod_q31)
+#define arm_dot_prod_q15   ARM_DISPATCH_X86_NAME(arm_dot_prod_q15)
+#define arm_dot_prod_q7    ARM_DISPATCH_X86_NAME(arm_dot_prod_q7)
+
+#include "../BasicMathFunctions/arm_dot_prod_f32.c"
+#include "../BasicMathFunctions/arm_dot_prod_q31.c"
+#include "../BasicMathFunctions/arm_dot_prod_q15.c"
+#include "../BasicMathFunctions/arm_dot_prod_q7.c"
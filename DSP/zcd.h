@@ -1,22 +1,131 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <utility>
+#if defined(__AVX__) || defined(__SSE__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(_M_X64)
+#include <immintrin.h>
+#define ZCD_SIMD_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ZCD_SIMD_NEON
+#endif
 
 /**
- * fs [Hz]: sampling frequency
+ * First index i in [from,n) with x[i-lag]*x[i] < 0 (n if there is none),
+ * from must be >= lag. lag is 1 for a single channel and the channel count
+ * for interleaved frames. Vectorized with AVX/SSE on x86, NEON on ARM
+ * A-profile, 4x unrolled loop otherwise (e.g. Cortex-M).
+ */
+inline size_t zcd_find_sign_change(const float* x,size_t from,size_t n,size_t lag)
+{
+    size_t i = from;
+#if defined(ZCD_SIMD_SSE)
+#if defined(__AVX__)
+    for( ; i+8 <= n ; i+=8 )
+    {
+        __m256 prod = _mm256_mul_ps(_mm256_loadu_ps(x+i-lag),_mm256_loadu_ps(x+i));
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(prod,_mm256_setzero_ps(),_CMP_LT_OQ));
+        if( mask != 0 )
+            return i + size_t(std::countr_zero(unsigned(mask)));
+    }
+#endif
+    for( ; i+4 <= n ; i+=4 )
+    {
+        __m128 prod = _mm_mul_ps(_mm_loadu_ps(x+i-lag),_mm_loadu_ps(x+i));
+        int mask = _mm_movemask_ps(_mm_cmplt_ps(prod,_mm_setzero_ps()));
+        if( mask != 0 )
+            return i + size_t(std::countr_zero(unsigned(mask)));
+    }
+#elif defined(ZCD_SIMD_NEON)
+    for( ; i+4 <= n ; i+=4 )
+    {
+        float32x4_t prod = vmulq_f32(vld1q_f32(x+i-lag),vld1q_f32(x+i));
+        uint32x4_t  lt   = vcltq_f32(prod,vdupq_n_f32(0.0f));
+        uint32x2_t  any  = vorr_u32(vget_low_u32(lt),vget_high_u32(lt));
+        if( vget_lane_u32(vpmax_u32(any,any),0) != 0 )
+            break;
+    }
+#else
+    for( ; i+4 <= n ; i+=4 )
+    {
+        bool c0 = x[i-lag  ] * x[i  ] < 0.0f;
+        bool c1 = x[i-lag+1] * x[i+1] < 0.0f;
+        bool c2 = x[i-lag+2] * x[i+2] < 0.0f;
+        bool c3 = x[i-lag+3] * x[i+3] < 0.0f;
+        if( c0 | c1 | c2 | c3 )
+            break;
+    }
+#endif
+    for( ; i < n ; i++ )
+        if( x[i-lag] * x[i] < 0.0f )
+            return i;
+    return n;
+}
+
+/**
+ * Zero crossing detector, the sampling configuration comes from t_Config:
+ *  zcd_t<fs,min_period,...>:  compile time configuration (fixed setups)
+ *  zcd_rt_t<...>(fs,min_period): run time configuration, one instantiation
+ *                             for every rate, the rate can be changed
+ * with
+ *  fs [Hz]: sampling frequency
+ *  min_period [seconds]: any period smaller than this value will be
+ *             considered as noise.
+ * The per-sample path (product/compare) does not depend on the
+ * configuration, the conversions from samples to seconds at the crossings
+ * use a cached 1/fs in zcd_rt_t (a multiply instead of a divide, the
+ * results can differ from zcd_t by one ulp).
+ *
+ * process_block(x,n) gives the same results as calling process_sample() on
+ * each sample: the sign changes are searched with zcd_find_sign_change()
+ * (vectorized), the samples between two candidates only update the counters
+ * and the interpolation/noise logic (and the callbacks) run only at the
+ * candidates.
+ *
+ * fit: how the crossing instant is found between the two samples around it
+ *      linear:    line through the 2 samples (default)
+ *      parabolic: parabola through the last 3 samples
+ *      cubic:     cubic through the last 4 samples
+ *      the polynomial root is refined with two Newton steps from the linear
+ *      estimate and kept between the two samples. The crossing of a pure
+ *      sine is an inflection point, so parabolic only pays off with a DC
+ *      offset or even harmonics (curvature at the crossing), cubic handles
+ *      both (~50 samples per period: period error 2e-6 -> 6e-8 on a sine,
+ *      4e-5 -> 5e-6 (parabolic) -> 2e-7 (cubic) with a 30% DC offset).
+ *
+ * stats_window: number of periods (sum of the last two half periods,
+ *      immune to a DC offset) kept for the running statistics: mean,
+ *      variance/jitter, frequency and RoCoF, updated in O(1) at each crossing
+ *      (sliding Welford, RoCoF: least squares slope of the frequency over
+ *      the window). 0 (default) disables them.
  *
- * min_period [seconds]: any period smaller than this value will be considered
- *             as noise.
+ * enable_pll(kp,ki) starts a second order tracker on the crossing instants
+ * (one polarity, once per period): the phase error is the distance between
+ * the measured crossing and the one predicted by the tracked period, the
+ * period is corrected by ki*error and the prediction by kp*error. It smooths
+ * the frequency without a window (typical gains: kp 0.1-0.3, ki kp^2/4).
+ *
+ * The estimators are updated before the callbacks, so a callback can read
+ * them. Everything is stored in the object (no allocation).
  */
-template<float fs,float min_period>
-class zcd_t
+enum class zcd_fit : uint8_t
 {
-    static_assert(fs > 0,
-                  "fs (sampling freq) must be greater than zero");
-    static_assert(min_period > 0,
-                  "min_period must be greater than zero");
-    static constexpr uint32_t _min_samples_per_period = fs*min_period/2.0f  ;
+    linear,
+    parabolic,
+    cubic
+};
+
+template<typename t_Config,zcd_fit fit,size_t stats_window>
+class zcd_base_t
+{
+    static_assert(stats_window != 1,
+                  "stats_window must be 0 (disabled) or greater than 1");
+    static constexpr size_t _history_len = fit == zcd_fit::cubic ? 2 : fit == zcd_fit::parabolic ? 1 : 0;
 public:
     void process_sample(float sample)
     {
@@ -32,10 +141,16 @@ public:
                     _zc_cnt++;
 
                 //compute zc time:
-                float m  = (sample-_prev_sample)*fs;
-                float zc_dt = -sample / m;
+                float zc_dt = 0;
+                if constexpr ( fit == zcd_fit::linear )
+                {
+                    float m  = (sample-_prev_sample)*_config.sampling_freq();
+                    zc_dt = -sample / m;
+                }
+                else
+                    zc_dt = _config.to_seconds(fit_zc(sample));
                 //compute period
-                auto half_period = float(_from_zc_cnt[2])*1.0f/fs + zc_dt - _prev_zc_dt;
+                auto half_period = _config.to_seconds(float(_from_zc_cnt[2])*1.0f) + zc_dt - _prev_zc_dt;
                 _prev_zc_dt = zc_dt;
 
                 _half_period[0] = _half_period[1];
@@ -45,6 +160,9 @@ public:
                 _from_zc_cnt[1] = _from_zc_cnt[2];
                 _from_zc_cnt[2] = 0;
 
+                if( _zc_cnt >= _from_zc_cnt.size() )
+                    update_estimators();
+
 //                if( _zc_cnt >= _from_zc_cnt.size() )
                 if( _zcd_callback != nullptr )
                     _zcd_callback();
@@ -54,28 +172,249 @@ public:
         }//end zc detection
         if( _zc_cnt != 0 )
             _from_zc_cnt[2]++;
-        _prev_sample = sample;
+        push_sample(sample);
+    }
+    void process_block(const float* x,size_t n)
+    {
+        size_t done = 0;
+        while( done < n )
+        {
+            size_t idx = find_candidate(x,done,n);
+            //no sign change in [done,idx): same as process_sample() without zc
+            size_t run = idx - done;
+            _zcd_global_counter += uint32_t(run);
+            if( _zc_cnt != 0 )
+                _from_zc_cnt[2] += uint32_t(run);
+            for( size_t k = run > _history_len+1 ? idx-_history_len-1 : done ; k<idx ; k++ )
+                push_sample(x[k]);
+            if( idx == n )
+                break;
+            process_sample(x[idx]);
+            done = idx + 1;
+        }
     }
     std::pair<float,float> get_half_period() const { return {_half_period[0],_half_period[1]}; }
+    //running statistics (stats_window > 0), over the last stats_count() periods
+    size_t stats_count() const { return _stats_cnt; }
+    float period_mean() const { return _period_mean; }
+    float period_variance() const { return _stats_cnt > 1 ? _period_m2 / float(_stats_cnt-1) : 0.0f; }
+    float jitter() const { return std::sqrt(std::max(period_variance(),0.0f)); }
+    float frequency() const { return _period_mean > 0.0f ? 1.0f/_period_mean : 0.0f; }
+    //[Hz/s] least squares slope of the frequency of the periods of the window
+    float rocof() const
+    {
+        if( _stats_cnt < 3 || _period_mean <= 0.0f )
+            return 0.0f;
+        double n   = double(_stats_cnt);
+        double sk  = n*(n-1.0)/2.0;
+        double sk2 = (n-1.0)*n*(2.0*n-1.0)/6.0;
+        double slope = (n*_freq_k_sum - sk*_freq_sum) / (n*sk2 - sk*sk);
+        //the periods are measured at each crossing (every half period)
+        return float(slope / (0.5*double(_period_mean)));
+    }
+    void reset_stats()
+    {
+        _stats_cnt = 0;
+        _stats_idx = 0;
+        _period_mean = 0;
+        _period_m2 = 0;
+        _freq_sum = 0;
+        _freq_k_sum = 0;
+    }
+    //PLL tracker
+    void enable_pll(float kp,float ki)
+    {
+        _pll_kp = kp;
+        _pll_ki = ki;
+        _pll_period = 0;
+        _pll_phase_error = 0;
+    }
+    void disable_pll() { _pll_kp = _pll_ki = 0; _pll_period = 0; }
+    float pll_frequency() const { return _pll_period > 0.0f ? 1.0f/_pll_period : 0.0f; }
+    float pll_phase_error() const { return _pll_phase_error; }
     void install_zcd_callback(void(*callback)()) { _zcd_callback = callback; }
     void install_zcd_metadata_callback(void(*callback)(uint32_t,uint32_t)) { _zcd_md_callback = callback; }
 protected:
+    //restarts the detection and the estimators (callbacks and PLL gains are kept)
+    void reset()
+    {
+        _from_zc_cnt = {};
+        _prev_sample = 0;
+        _prev_zc_dt  = 0;
+        _half_period = {};
+        _zc_cnt = 0;
+        _history = {};
+        reset_stats();
+        _pll_period = 0;
+        _pll_phase_error = 0;
+    }
     bool zc_noisy() const
     {
         if( _from_zc_cnt[2] < std::min(_from_zc_cnt[0],_from_zc_cnt[1])/4 ||
-            _from_zc_cnt[2] < _min_samples_per_period/2 )
+            _from_zc_cnt[2] < _config.min_samples_per_period()/2 )
             return true;
         return false;
     }
+    //index of the first sample in [from,n) whose product with the previous
+    //one is negative (the test of process_sample()), n if there is none
+    size_t find_candidate(const float* x,size_t from,size_t n) const
+    {
+        if( from == n || _prev_sample * x[from] < 0.0f )
+            return from;
+        return zcd_find_sign_change(x,from+1,n,1);
+    }
+    void push_sample(float sample)
+    {
+        if constexpr ( _history_len != 0 )
+        {
+            for( size_t i=_history_len-1 ; i>0 ; i-- )
+                _history[i] = _history[i-1];
+            _history[0] = _prev_sample;
+        }
+        _prev_sample = sample;
+    }
+    //crossing instant in samples relative to sample, in [-1,0]: root of the
+    //backward Newton polynomial through the last samples
+    float fit_zc(float sample) const
+    {
+        float d1 = sample - _prev_sample;
+        float t  = -sample / d1;
+        float c2 = (d1 - (_prev_sample - _history[0])) * 0.5f;
+        float c3 = 0;
+        if constexpr ( fit == zcd_fit::cubic )
+            c3 = (sample - 3.0f*_prev_sample + 3.0f*_history[0] - _history[1]) * (1.0f/6.0f);
+        for( uint8_t iter=0 ; iter<2 ; iter++ )
+        {
+            float p  = sample + t*(d1 + (t+1.0f)*(c2 + (t+2.0f)*c3));
+            float dp = d1 + (2.0f*t+1.0f)*c2 + (3.0f*t*t+6.0f*t+2.0f)*c3;
+            if( dp * d1 <= 0.0f )
+                break;      //not monotonic here: keep the previous estimate
+            t -= p / dp;
+        }
+        return std::clamp(t,-1.0f,0.0f);
+    }
+    void update_estimators()
+    {
+        //period: sum of the last two half periods (immune to a DC offset)
+        float period = _half_period[0] + _half_period[1];
+        if constexpr ( stats_window != 0 )
+        {
+            //sliding Welford for mean/variance, sliding sums (double: the
+            //slope is a difference of large sums) for the RoCoF regression
+            double freq = 1.0/double(period);
+            if( _stats_cnt < stats_window )
+            {
+                _freq_k_sum += double(_stats_cnt) * freq;
+                _freq_sum += freq;
+                _stats_cnt++;
+                float delta = period - _period_mean;
+                _period_mean += delta / float(_stats_cnt);
+                _period_m2 += delta * (period - _period_mean);
+            }
+            else
+            {
+                float old = _periods[_stats_idx];
+                double old_freq = 1.0/double(old);
+                _freq_k_sum += double(stats_window-1)*freq - (_freq_sum - old_freq);
+                _freq_sum += freq - old_freq;
+                float old_mean = _period_mean;
+                _period_mean += (period - old) / float(stats_window);
+                _period_m2 += (period - old) * (period - _period_mean + old - old_mean);
+            }
+            _periods[_stats_idx] = period;
+            _stats_idx = (_stats_idx + 1) % stats_window;
+        }
+        //the PLL follows the crossings of one polarity (one per period)
+        _pll_odd = !_pll_odd;
+        if( (_pll_kp != 0.0f || _pll_ki != 0.0f) && _pll_odd )
+        {
+            if( _pll_period <= 0.0f )
+            {
+                _pll_period = period;
+                _pll_phase_error = 0;
+                return;
+            }
+            //measured crossing minus predicted crossing
+            float error = _pll_phase_error + period - _pll_period;
+            _pll_period += _pll_ki * error;
+            _pll_phase_error = error * (1.0f - _pll_kp);
+        }
+    }
+protected:
+    [[no_unique_address]] t_Config _config;
 private:
-    std::array<uint32_t,3>  _from_zc_cnt;
+    std::array<uint32_t,3>  _from_zc_cnt{};
     float                   _prev_sample = 0;
     float                   _prev_zc_dt  = 0;
-    std::array<float,2>     _half_period;
+    std::array<float,2>     _half_period{};
     void(*_zcd_callback)()                          = nullptr;
     void(*_zcd_md_callback)(uint32_t,uint32_t)      = nullptr;
     uint32_t                _zcd_global_counter     = 0;
     uint32_t                _samples_global_counter = 0;
     uint8_t  _zc_cnt = 0;
+    std::array<float,_history_len> _history{};
+    std::array<float,stats_window> _periods{};
+    size_t                  _stats_cnt   = 0;
+    size_t                  _stats_idx   = 0;
+    float                   _period_mean = 0;
+    float                   _period_m2   = 0;
+    double                  _freq_sum    = 0;
+    double                  _freq_k_sum  = 0;
+    float                   _pll_kp = 0;
+    float                   _pll_ki = 0;
+    float                   _pll_period = 0;
+    float                   _pll_phase_error = 0;
+    bool                    _pll_odd = false;
+};
+
+template<float fs,float min_period>
+struct zcd_static_config_t
+{
+    static_assert(fs > 0,
+                  "fs (sampling freq) must be greater than zero");
+    static_assert(min_period > 0,
+                  "min_period must be greater than zero");
+    static constexpr float sampling_freq() { return fs; }
+    static constexpr float to_seconds(float samples) { return samples/fs; }
+    static constexpr uint32_t min_samples_per_period() { return fs*min_period/2.0f; }
+};
+
+struct zcd_runtime_config_t
+{
+    float       _fs     = 1;
+    float       _inv_fs = 1;
+    uint32_t    _min_samples_per_period = 0;
+    float sampling_freq() const { return _fs; }
+    float to_seconds(float samples) const { return samples*_inv_fs; }
+    uint32_t min_samples_per_period() const { return _min_samples_per_period; }
+};
+
+template<float fs,float min_period,zcd_fit fit = zcd_fit::linear,size_t stats_window = 0>
+class zcd_t : public zcd_base_t<zcd_static_config_t<fs,min_period>,fit,stats_window>
+{
+};
+
+template<zcd_fit fit = zcd_fit::linear,size_t stats_window = 0>
+class zcd_rt_t : public zcd_base_t<zcd_runtime_config_t,fit,stats_window>
+{
+public:
+    zcd_rt_t(float fs,float min_period) { set_sampling(fs,min_period); }
+    //returns false (and keeps the previous configuration) if fs or
+    //min_period is not greater than zero, a new configuration restarts the
+    //detection (the sample counts of the previous rate are meaningless)
+    bool set_sampling(float fs,float min_period)
+    {
+        if( !(fs > 0.0f) || !(min_period > 0.0f) )
+            return false;
+        this->_config._fs     = fs;
+        this->_config._inv_fs = 1.0f/fs;
+        this->_config._min_samples_per_period = uint32_t(fs*min_period/2.0f);
+        this->reset();
+        return true;
+    }
+    float get_fs() const { return this->_config._fs; }
 };
 
+//the SIMD selection is private to this header
+#undef ZCD_SIMD_SSE
+#undef ZCD_SIMD_NEON
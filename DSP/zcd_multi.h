@@ -0,0 +1,110 @@
+#pragma once
+
+#include "zcd.h"
+
+/**
+ * Zero crossing detector for K channels sampled together (interleaved
+ * frames: x[frame*K + channel]), same detection, noise rejection and
+ * interpolation as zcd_t, one instance instead of K.
+ *
+ * The state is stored as structure of arrays (one array per field, indexed
+ * by channel) and the whole interleaved buffer is scanned in one pass with
+ * zcd_find_sign_change(x,..,lag=K) (vectorized across channels), only the
+ * channels that crossed zero are touched. The sample counters of zcd_t are
+ * replaced by the frame index of the last crossing, so nothing is updated
+ * per sample.
+ *
+ * There are no callbacks: process_frames() returns a batch result with, for
+ * each channel, the number of crossings accepted in the call, the last half
+ * period and the frequency (1/(sum of the last two half periods), 0 until
+ * three crossings were seen).
+ *
+ * Example (3-phase monitoring, 4 feeders):
+ *  zcd_multi_t<200000.0f,0.01f,12> zcd;
+ *  auto& res = zcd.process_frames(adc_frames,frames_count);
+ *  for( size_t ch=0 ; ch<12 ; ch++ )
+ *      if( res.crossings[ch] != 0 )
+ *          publish(ch,res.frequency[ch]);
+ */
+template<float fs,float min_period,size_t K>
+class zcd_multi_t
+{
+    static_assert(fs > 0,
+                  "fs (sampling freq) must be greater than zero");
+    static_assert(min_period > 0,
+                  "min_period must be greater than zero");
+    static_assert(K > 0,
+                  "K (channels) must be greater than zero");
+    static constexpr uint32_t _min_samples_per_period = fs*min_period/2.0f  ;
+public:
+    struct result_t
+    {
+        std::array<uint32_t,K> crossings{};     //accepted in the last call
+        std::array<float,K>    half_period{};   //[s]
+        std::array<float,K>    frequency{};     //[Hz]
+    };
+public:
+    const result_t& process_frames(const float* x,size_t frames)
+    {
+        _result.crossings = {};
+        if( frames == 0 )
+            return _result;
+        //first frame: the previous samples are in the state
+        for( size_t ch=0 ; ch<K ; ch++ )
+            if( _prev_sample[ch] * x[ch] < 0.0f )
+                process_zc(ch,_frames,_prev_sample[ch],x[ch]);
+        size_t n = frames*K;
+        size_t idx = K;
+        while( (idx = zcd_find_sign_change(x,idx,n,K)) < n )
+        {
+            process_zc(idx%K,_frames + uint32_t(idx/K),x[idx-K],x[idx]);
+            idx++;
+        }
+        for( size_t ch=0 ; ch<K ; ch++ )
+        {
+            _prev_sample[ch] = x[n-K+ch];
+            if( _result.crossings[ch] != 0 )
+            {
+                _result.half_period[ch] = _half_period1[ch];
+                _result.frequency[ch] = _zc_cnt[ch] >= 3 ? 1.0f/(_half_period0[ch] + _half_period1[ch]) : 0.0f;
+            }
+        }
+        _frames += uint32_t(frames);
+        return _result;
+    }
+    const result_t& result() const { return _result; }
+    std::pair<float,float> get_half_period(size_t ch) const { return {_half_period0[ch],_half_period1[ch]}; }
+protected:
+    void process_zc(size_t ch,uint32_t frame,float prev_sample,float sample)
+    {
+        //samples since the last crossing (the _from_zc_cnt[2] of zcd_t)
+        uint32_t from_zc_cnt = _zc_cnt[ch] != 0 ? frame - _zc_frame[ch] : 0;
+        bool noisy = from_zc_cnt < std::min(_from_zc_cnt0[ch],_from_zc_cnt1[ch])/4 ||
+                     from_zc_cnt < _min_samples_per_period/2;
+        if( noisy && _zc_cnt[ch] >= 3 )
+            return;
+        if( _zc_cnt[ch] < 3 )
+            _zc_cnt[ch]++;
+        float m  = (sample-prev_sample)*fs;
+        float zc_dt = -sample / m;
+        float half_period = float(from_zc_cnt)*1.0f/fs + zc_dt - _prev_zc_dt[ch];
+        _prev_zc_dt[ch] = zc_dt;
+        _half_period0[ch] = _half_period1[ch];
+        _half_period1[ch] = half_period;
+        _from_zc_cnt0[ch] = _from_zc_cnt1[ch];
+        _from_zc_cnt1[ch] = from_zc_cnt;
+        _zc_frame[ch] = frame;
+        _result.crossings[ch]++;
+    }
+private:
+    std::array<float,K>     _prev_sample{};
+    std::array<float,K>     _prev_zc_dt{};
+    std::array<float,K>     _half_period0{};
+    std::array<float,K>     _half_period1{};
+    std::array<uint32_t,K>  _from_zc_cnt0{};
+    std::array<uint32_t,K>  _from_zc_cnt1{};
+    std::array<uint32_t,K>  _zc_frame{};
+    std::array<uint8_t,K>   _zc_cnt{};
+    uint32_t                _frames = 0;
+    result_t                _result;
+};
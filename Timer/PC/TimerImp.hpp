@@ -1,6 +1,10 @@
 #pragma once
 
 #include "../Timer.hpp"
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 inline uint64_t sysTick_ms()
 {
@@ -19,6 +23,75 @@ inline uint32_t sysTick32_us()
     return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 }
 
+/*
+Monotonic sources (the system_clock ones above jump when the wall clock is
+adjusted):
+ steadyTick: std::chrono::steady_clock
+ coarseTick: CLOCK_MONOTONIC_COARSE, no syscall and no division by the clock
+             frequency, but the resolution is the kernel tick (1-4ms)
+ tscTick:    time stamp counter (x86 only, needs an invariant tsc), the
+             frequency is calibrated against steady_clock on the first
+             call (20ms busy wait, call tscCalibration() at startup to pay
+             it there) and the conversion is a multiply and a shift
+*/
+inline uint64_t steadyTick_us()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+inline uint64_t steadyTick_ms()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+inline uint32_t steadyTick32_us() { return uint32_t(steadyTick_us()); }
+inline uint32_t steadyTick32_ms() { return uint32_t(steadyTick_ms()); }
+
+inline uint64_t coarseTick_ms()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE,&ts);
+    return uint64_t(ts.tv_sec)*1000u + uint64_t(ts.tv_nsec)/1000000u;
+}
+inline uint32_t coarseTick32_ms() { return uint32_t(coarseTick_ms()); }
+
+#if defined(__x86_64__) || defined(__i386__)
+struct TscCalibration
+{
+    //us since the calibration = ((tsc-base)*mult) >> 32
+    uint64_t base;
+    uint64_t mult;
+    static TscCalibration calibrate()
+    {
+        using Clock = std::chrono::steady_clock;
+        auto t0 = Clock::now();
+        uint64_t c0 = __rdtsc();
+        while( Clock::now()-t0 < std::chrono::milliseconds(20) );
+        auto t1 = Clock::now();
+        uint64_t c1 = __rdtsc();
+        long double us = std::chrono::duration<long double,std::micro>(t1-t0).count();
+        return { c0 , uint64_t(us*4294967296.0L/(c1-c0)) };
+    }
+};
+//calibrated on the first use, not during the static initialization (the
+//programs that never read the tsc do not pay the 20ms)
+inline const TscCalibration& tscCalibration()
+{
+    static const TscCalibration calibration = TscCalibration::calibrate();
+    return calibration;
+}
+
+inline uint64_t tscTick_us()
+{
+    const TscCalibration& calibration = tscCalibration();
+    uint64_t cycles = __rdtsc() - calibration.base;
+#if defined(__SIZEOF_INT128__)
+    return uint64_t((unsigned __int128)cycles*calibration.mult >> 32);
+#else
+    return uint64_t((long double)cycles*calibration.mult/4294967296.0L);
+#endif
+}
+inline uint32_t tscTick32_us() { return uint32_t(tscTick_us()); }
+#endif
+
 inline uint32_t tick_cnt = 0;
 inline void tim_inc()
 {
@@ -36,3 +109,22 @@ using Tim32_us = mcu::Timer<uint32_t,1,1000000  ,sysTick32_us>;
 
 using Tim32_loop_us = mcu::Timer<uint32_t,1,1000000  ,tim_ms>;
 using Tim32_loop_ms = mcu::Timer<uint32_t,1,1000     ,tim_ms>;
+
+using Tim64_steady_ms = mcu::Timer<uint64_t,1,1000     ,steadyTick_ms>;
+using Tim64_steady_us = mcu::Timer<uint64_t,1,1000000  ,steadyTick_us>;
+using Tim32_steady_ms = mcu::Timer<uint32_t,1,1000     ,steadyTick32_ms>;
+using Tim32_steady_us = mcu::Timer<uint32_t,1,1000000  ,steadyTick32_us>;
+
+using Tim64_coarse_ms = mcu::Timer<uint64_t,1,1000     ,coarseTick_ms>;
+using Tim32_coarse_ms = mcu::Timer<uint32_t,1,1000     ,coarseTick32_ms>;
+
+#if defined(__x86_64__) || defined(__i386__)
+using Tim64_tsc_us = mcu::Timer<uint64_t,1,1000000  ,tscTick_us>;
+using Tim32_tsc_us = mcu::Timer<uint32_t,1,1000000  ,tscTick32_us>;
+#endif
+
+//cached mode: call TickCache*::update() once per loop iteration
+using TickCache64_us = mcu::CachedTime<uint64_t,steadyTick_us>;
+using TickCache32_us = mcu::CachedTime<uint32_t,steadyTick32_us>;
+using Tim64_cached_us = mcu::Timer<uint64_t,1,1000000  ,TickCache64_us::get>;
+using Tim32_cached_us = mcu::Timer<uint32_t,1,1000000  ,TickCache32_us::get>;
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Timer.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+
+namespace mcu
+{
+
+/** @brief Scoped profiling probes
+ *
+ * ProfileProbe<t_Timer> collects the statistics of a code section measured
+ * in ticks of @arg t_Timer (any mcu::Timer, a hardware cycle counter gives
+ * the best resolution): count, min, max, mean and a log2 histogram with
+ * @arg t_bins bins (bin i counts the durations in [2^(i-1),2^i) ticks, bin 0
+ * the zero durations, the last bin everything above).
+ *
+ * Probes register themselves (intrusive list per timer type, no allocation)
+ * when constructed, so they are meant to be static. A Scope guard reads the
+ * clock when created and when destroyed, recording costs a few additions, two
+ * comparisons and a count leading zeros.
+ *
+ * Example:
+ *  void loop()
+ *  {
+ *      {
+ *          MCU_PROFILE_SCOPE(CycleTimer,"rxTask");
+ *          serial.rxTask();
+ *      }
+ *      ...
+ *  }
+ *
+ * The probes are walked with first()/next(); Comm/ProfilerCmd.h has a
+ * CmdParser handler that prints them.
+ *
+ * Defining MCU_PROFILER_DISABLED turns MCU_PROFILE_SCOPE into nothing.
+ */
+template<typename t_Timer,uint8_t t_bins = 16>
+class ProfileProbe
+{
+private:
+    static_assert(is_mcu_timer<t_Timer>::value,"t_Timer must be an mcu::Timer");
+    static_assert(t_bins > 1,"t_bins must be greater than one");
+    using Ticks = typename t_Timer::TimerResolution;
+public:
+    static constexpr uint8_t bins = t_bins;
+
+    class Scope
+    {
+    public:
+        Scope(ProfileProbe& probe) : _probe(probe),_start(t_Timer::now()) {}
+        ~Scope() { _probe.record(Ticks(t_Timer::now() - _start)); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        ProfileProbe& _probe;
+        Ticks _start;
+    };
+public:
+    ProfileProbe(std::string_view name) : _name(name)
+    {
+        //appended at the end, so the dump follows the registration order
+        ProfileProbe** last = &_first;
+        while( *last != nullptr )
+            last = &(*last)->_next;
+        *last = this;
+    }
+    ProfileProbe(const ProfileProbe&) = delete;
+    ProfileProbe& operator=(const ProfileProbe&) = delete;
+    void record(Ticks ticks)
+    {
+        _min = std::min(_min,ticks);
+        _max = std::max(_max,ticks);
+        _sum += ticks;
+        _count++;
+        _hist[std::min<uint8_t>(uint8_t(std::bit_width(ticks)),t_bins-1)]++;
+    }
+    void reset()
+    {
+        _min = Ticks(-1);
+        _max = 0;
+        _sum = 0;
+        _count = 0;
+        _hist = {};
+    }
+    std::string_view name() const { return _name; }
+    uint32_t count() const { return _count; }
+    Ticks min() const { return _count != 0 ? _min : Ticks(0); }
+    Ticks max() const { return _max; }
+    Ticks mean() const { return _count != 0 ? Ticks(_sum/_count) : Ticks(0); }
+    uint32_t histogram(uint8_t bin) const { return bin < t_bins ? _hist[bin] : 0; }
+    static ProfileProbe* first() { return _first; }
+    ProfileProbe* next() const { return _next; }
+private:
+    static inline ProfileProbe* _first = nullptr;
+    ProfileProbe* _next = nullptr;
+    std::string_view _name;
+    Ticks _min = Ticks(-1);
+    Ticks _max = 0;
+    uint64_t _sum = 0;
+    uint32_t _count = 0;
+    std::array<uint32_t,t_bins> _hist{};
+};
+
+}//namespace mcu
+
+#define MCU_PROFILE_CONCAT_(a,b) a##b
+#define MCU_PROFILE_CONCAT(a,b) MCU_PROFILE_CONCAT_(a,b)
+#ifndef MCU_PROFILER_DISABLED
+#define MCU_PROFILE_SCOPE(t_Timer,name)                                                           \
+    static ::mcu::ProfileProbe<t_Timer> MCU_PROFILE_CONCAT(_mcuProbe,__LINE__)(name);             \
+    typename ::mcu::ProfileProbe<t_Timer>::Scope MCU_PROFILE_CONCAT(_mcuProbeScope,__LINE__)(MCU_PROFILE_CONCAT(_mcuProbe,__LINE__))
+#else
+#define MCU_PROFILE_SCOPE(t_Timer,name)
+#endif
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "Timer.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace mcu
+{
+
+/** @brief Cooperative deadline-driven scheduler
+ *
+ * Replaces a super-loop that calls every task on every iteration: each task
+ * is a run function and a wake function that returns the ticks of @arg
+ * t_Timer until the task has work (0: runnable now, Scheduler::never: no
+ * work until something external happens). run() evaluates the wake
+ * functions, calls the runnable tasks in priority order (lower value first,
+ * registration order for equal priorities) and returns the ticks until the
+ * earliest wake, so the caller can sleep (hosts) or enter a low power mode
+ * (MCUs) until then.
+ *
+ * The latency of each task (from the tick it became due to the tick it
+ * started running) is recorded, see stats(). Tasks that become runnable by
+ * an external event (a byte received) are due when the scheduler first sees
+ * them runnable, so their latency is the time spent behind the higher
+ * priority tasks.
+ *
+ * The components expose what the wake functions need: Serial::rxWakeIn(),
+ * Serial::txWakeIn() and CmdParser::hasWork().
+ *
+ * Example:
+ *  mcu::Scheduler<Tim32_us,4> sched;
+ *  sched.add(0,[](void*){ serial.rxTask(); },[](void*) -> uint32_t
+ *  {
+ *      return Uart::rxAvailable() ? 0 : Tim32_us::toTicks(serial.rxWakeIn());
+ *  });
+ *  sched.add(1,[](void*){ parser(); },[](void*) -> uint32_t
+ *  {
+ *      return parser.hasWork() ? 0 : sched.never;
+ *  });
+ *  while(1)
+ *  {
+ *      auto next = sched.run();
+ *      //host: bound the sleep by the polling period of the event driven tasks
+ *      std::this_thread::sleep_for(Tim32_us::IncPeriod(std::min<uint32_t>(next,1000)));
+ *  }
+ */
+template<typename t_Timer,uint8_t t_maxTasks>
+class Scheduler
+{
+private:
+    static_assert(is_mcu_timer<t_Timer>::value,"t_Timer must be an mcu::Timer");
+    static_assert(t_maxTasks > 0,"t_maxTasks must be greater than zero");
+public:
+    using Ticks  = typename t_Timer::TimerResolution;
+    using RunFn  = void(*)(void*);
+    using WakeFn = Ticks(*)(void*);
+    static constexpr Ticks never = Ticks(-1);
+    static constexpr uint8_t invalidId = t_maxTasks;
+
+    struct Stats
+    {
+        uint32_t runs = 0;
+        Ticks    lastLatency = 0;
+        Ticks    maxLatency  = 0;
+        uint64_t sumLatency  = 0;
+        Ticks meanLatency() const { return runs != 0 ? Ticks(sumLatency/runs) : Ticks(0); }
+    };
+private:
+    static constexpr Ticks halfRange = Ticks(Ticks(1) << (8*sizeof(Ticks)-1));
+    struct Task
+    {
+        RunFn    run;
+        WakeFn   wake;
+        void*    ctx;
+        uint8_t  priority;
+        bool     dueValid;
+        Ticks    due;
+        Stats    stats;
+    };
+public:
+    //returns the id of the task (invalidId if there is no room)
+    uint8_t add(uint8_t priority,RunFn run,WakeFn wake,void* ctx = nullptr)
+    {
+        if( _count == t_maxTasks || run == nullptr || wake == nullptr )
+            return invalidId;
+        uint8_t id = _count++;
+        _tasks[id] = Task{run,wake,ctx,priority,false,0,{}};
+        //insertion in _order (stable: after the tasks of the same priority)
+        uint8_t pos = id;
+        while( pos > 0 && _tasks[_order[pos-1]].priority > priority )
+        {
+            _order[pos] = _order[pos-1];
+            pos--;
+        }
+        _order[pos] = id;
+        return id;
+    }
+    //one pass, returns the ticks until the earliest wake (0 if any task ran)
+    Ticks run()
+    {
+        Ticks next = never;
+        Ticks now = t_Timer::now();
+        for( uint8_t i=0 ; i<_count ; i++ )
+        {
+            Task& task = _tasks[_order[i]];
+            Ticks wake = task.wake(task.ctx);
+            if( wake != 0 )
+            {
+                if( wake != never )
+                {
+                    task.due = Ticks(now + wake);
+                    task.dueValid = true;
+                }
+                else
+                    task.dueValid = false;
+                next = std::min(next,wake);
+                continue;
+            }
+            now = t_Timer::now();
+            Ticks late = 0;
+            if( task.dueValid && Ticks(now - task.due) < halfRange )
+                late = Ticks(now - task.due);
+            task.stats.runs++;
+            task.stats.lastLatency = late;
+            task.stats.maxLatency = std::max(task.stats.maxLatency,late);
+            task.stats.sumLatency += late;
+            task.dueValid = false;
+            task.run(task.ctx);
+            next = 0;
+        }
+        return next;
+    }
+    const Stats& stats(uint8_t id) const { return _tasks[std::min<uint8_t>(id,t_maxTasks-1)].stats; }
+    void resetStats()
+    {
+        for( uint8_t i=0 ; i<_count ; i++ )
+            _tasks[i].stats = {};
+    }
+    uint8_t count() const { return _count; }
+private:
+    std::array<Task,t_maxTasks> _tasks{};
+    std::array<uint8_t,t_maxTasks> _order{};
+    uint8_t _count = 0;
+};
+
+}//namespace mcu
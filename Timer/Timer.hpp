@@ -7,8 +7,10 @@
 
 #pragma once
 
+#include <bit>
 #include <chrono>
 #include <cstdint>
+#include <ratio>
 
 using namespace std::chrono_literals;
 
@@ -76,6 +78,57 @@ public:
     //seconds to overflow (timer module)
     static constexpr auto overflow_time = t_TimerResolution(ldouble_t(t_TimerResolution(-1))*ldouble_t(t_Num)/ldouble_t(t_Den));
     static constexpr void hardwareInit() { t_HardwareInit(); }
+    static t_TimerResolution now() { return t_GetTime(); }
+    /*
+    Converts a duration to ticks, rounded up so that a timeout or a Deadline
+    never expires before the duration elapsed (a 2.5ms Deadline on a 1ms
+    tick is 3 ticks). For constants it is evaluated at compile time:
+        constexpr auto timeout = Tim32_us::toTicks(10ms);
+        if( tim >= timeout )
+    At run time it needs no division when the duration period is an integer
+    multiple (multiply) or a power of two fraction (shift) of IncPeriod, and a
+    multiply-shift by the reciprocal otherwise.
+    */
+    template<typename t_Rep,typename t_Period>
+    static constexpr t_TimerResolution toTicks(std::chrono::duration<t_Rep,t_Period> dt)
+    {
+        using Ratio = std::ratio_divide<t_Period,std::ratio<t_Num,t_Den>>;
+        return t_TimerResolution(divide<uint64_t(Ratio::den)>(uint64_t(dt.count())*uint64_t(Ratio::num) + uint64_t(Ratio::den-1)));
+    }
+    /*
+    Expiry tick computed once, so polling it costs one clock read, one
+    subtraction and one comparison (valid for deadlines shorter than half
+    the overflow time).
+        Tim32_us::Deadline deadline(10ms);
+        while( !deadline.expired() );
+        deadline.extend(10ms);  //next period, without drift
+    */
+    class Deadline
+    {
+    private:
+        static constexpr t_TimerResolution halfRange = t_TimerResolution(t_TimerResolution(1) << (8*sizeof(t_TimerResolution)-1));
+    public:
+        //already expired
+        Deadline() : _expiry(t_GetTime()) {}
+        explicit Deadline(t_TimerResolution ticks) : _expiry(t_TimerResolution(t_GetTime() + ticks)) {}
+        template<typename t_Rep,typename t_Period>
+        Deadline(std::chrono::duration<t_Rep,t_Period> dt) : Deadline(toTicks(dt)) {}
+        bool expired() const
+        {
+            return t_TimerResolution(t_GetTime() - _expiry) < halfRange;
+        }
+        t_TimerResolution remaining() const
+        {
+            t_TimerResolution left = t_TimerResolution(_expiry - t_GetTime());
+            return left < halfRange ? left : t_TimerResolution(0);
+        }
+        void extend(t_TimerResolution ticks) { _expiry += ticks; }
+        template<typename t_Rep,typename t_Period>
+        void extend(std::chrono::duration<t_Rep,t_Period> dt) { extend(toTicks(dt)); }
+        t_TimerResolution expiry() const { return _expiry; }
+    private:
+        t_TimerResolution _expiry;
+    };
 public:
     Timer(bool start=true) : _tick(0),_running(start){ if(start) this->start(); }
     void restart(){ start(); }
@@ -171,11 +224,56 @@ public:
     {
         return _tick;
     }
+private:
+    template<uint64_t t_div>
+    static constexpr uint64_t divide(uint64_t n)
+    {
+        if constexpr ( t_div == 1 )
+            return n;
+        else if constexpr ( std::has_single_bit(t_div) )
+            return n >> std::countr_zero(t_div);
+        else if constexpr ( t_div < (uint64_t(1) << 32) )
+        {
+            //Granlund-Montgomery, exact for any 32 bit n
+            constexpr uint8_t l = uint8_t(std::bit_width(t_div-1));
+            constexpr uint64_t m = ((uint64_t(1) << 32)*((uint64_t(1) << l) - t_div))/t_div + 1;
+            if( (n >> 32) != 0 )
+                return n / t_div;
+            uint64_t t = (n*m) >> 32;
+            return (t + ((n-t) >> 1)) >> (l-1);
+        }
+        else
+            return n / t_div;
+    }
 private:
     t_TimerResolution _tick;
     bool _running;
 };
 
+/** @brief Cached time source
+ *
+ * Serves the value read by the last update() to every Timer that uses get()
+ * as its t_GetTime, so one clock read per loop iteration serves all the
+ * comparisons done in that iteration (resolution = loop period).
+ *
+ * Example:
+ *  using Clock = mcu::CachedTime<uint32_t,sysTick32_us>;
+ *  using TimCached = mcu::Timer<uint32_t,1,1000000,Clock::get>;
+ *  while(1)
+ *  {
+ *      Clock::update();
+ *      ...all the TimCached comparisons...
+ *  }
+ */
+template<typename t_TimerResolution,t_TimerResolution(*t_GetTime)()>
+struct CachedTime
+{
+    static void update() { _value = t_GetTime(); }
+    static t_TimerResolution get() { return _value; }
+private:
+    static inline t_TimerResolution _value = t_GetTime();
+};
+
 template<typename>
 struct is_mcu_timer : std::false_type {};
 
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "Timer.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace mcu
+{
+
+/** @brief Hierarchical timing wheel
+ *
+ * Schedules many timeouts and periodic jobs on top of a single time source:
+ * the clock (@arg t_GetTime) is read once per call to task(), instead of once
+ * per mcu::Timer comparison.
+ *
+ * Template @arg t_TimerResolution, @arg t_Num, @arg t_Den and @arg t_GetTime
+ * have the same meaning as in mcu::Timer (the wheel tick is the timer tick).
+ * The counter wrap of t_GetTime is handled by accumulating the elapsed ticks
+ * in a 64 bit counter, so task() must be called at least once per overflow
+ * period of t_TimerResolution.
+ *
+ * Template @arg t_levels and @arg t_slotBits define the geometry: each level
+ * has 2^t_slotBits slots and level k covers delays up to 2^(t_slotBits*(k+1))
+ * ticks. Longer delays are parked in the last level and re-evaluated on each
+ * of its turns. Defaults: 4 levels of 64 slots (2^24 ticks ~ 16.7s at 1us).
+ *
+ * Entries are intrusive (owned by the caller, no allocation): start() and
+ * cancel() are O(1), task() jumps to the next occupied slot of any level
+ * using one occupancy bitmap per level, so idle slots and empty turns cost
+ * nothing. An Entry must not be
+ * destroyed while it is active (cancel it first).
+ *
+ * Example:
+ *  using Wheel = mcu::TimerWheel<uint32_t,1,1000000,sysTick32_us>;
+ *  Wheel wheel;
+ *  Wheel::Entry blink([](void*){ toggle_led(); });
+ *  wheel.start(blink,500ms,500ms);   //first expiry, period
+ *  while(1)
+ *      wheel.task();
+ */
+template<   typename t_TimerResolution,
+            intmax_t t_Num,
+            intmax_t t_Den,
+            t_TimerResolution(*t_GetTime)(),
+            uint8_t t_levels   = 4,
+            uint8_t t_slotBits = 6>
+class TimerWheel
+{
+private:
+    static_assert(t_GetTime != nullptr,"t_GetTime must be not nullptr");
+    static_assert(t_levels > 0,"t_levels must be greater than zero");
+    static_assert(t_slotBits > 0 && t_slotBits <= 6,"t_slotBits must be in the range [1,6]");
+    static_assert(t_levels*t_slotBits < 64,"t_levels*t_slotBits must be lower than 64");
+    static constexpr uint32_t slots = 1u << t_slotBits;
+    static constexpr uint64_t mask  = slots - 1;
+    static constexpr uint64_t span  = uint64_t(1) << (t_levels*t_slotBits);
+public:
+    using TimerResolution = t_TimerResolution;
+    using IncPeriod = std::chrono::duration< t_TimerResolution , std::ratio<t_Num,t_Den> >;
+
+    class Entry
+    {
+    public:
+        Entry(void(*callback)(void*),void* arg = nullptr) : _callback(callback),_arg(arg) {}
+        Entry(const Entry&) = delete;
+        Entry& operator=(const Entry&) = delete;
+        bool active() const { return _pprev != nullptr; }
+    private:
+        friend class TimerWheel;
+        Entry*   _next  = nullptr;
+        Entry**  _pprev = nullptr;
+        uint64_t _expires = 0;
+        uint64_t _period  = 0;
+        uint8_t  _level = 0;
+        uint8_t  _slot  = 0;
+        void(*_callback)(void*);
+        void* _arg;
+    };
+public:
+    TimerWheel() : _last(t_GetTime()) {}
+    //schedules e to expire after delay (at least one tick), then every
+    //period if period is not zero (no drift: the period is added to the
+    //expiry tick). A running entry is rescheduled.
+    template<typename t_Rep,typename t_Period,typename t_PRep = t_Rep,typename t_PPeriod = t_Period>
+    void start(Entry& e,std::chrono::duration<t_Rep,t_Period> delay,std::chrono::duration<t_PRep,t_PPeriod> period = {})
+    {
+        start(e,uint64_t(std::chrono::duration_cast<IncPeriod>(delay).count()),
+                uint64_t(std::chrono::duration_cast<IncPeriod>(period).count()));
+    }
+    void start(Entry& e,uint64_t delayTicks,uint64_t periodTicks = 0)
+    {
+        cancel(e);
+        e._expires = _now + (delayTicks != 0 ? delayTicks : 1);
+        e._period  = periodTicks;
+        insert(e);
+    }
+    void cancel(Entry& e)
+    {
+        if( e.active() )
+            unlink(e);
+    }
+    //reads the clock once and fires the expired entries
+    void task()
+    {
+        t_TimerResolution now = t_GetTime();
+        advance(_now + t_TimerResolution(now - _last));
+        _last = now;
+    }
+    //ticks elapsed since the wheel was created (as seen by the last task())
+    uint64_t ticks() const { return _now; }
+    IncPeriod now() const { return IncPeriod(t_TimerResolution(_now)); }
+    size_t activeCount() const { return _active; }
+private:
+    void advance(uint64_t target)
+    {
+        while( true )
+        {
+            uint64_t next = nextEvent();
+            if( next > target )
+                break;
+            _now = next;
+            if( (_now & mask) == 0 )
+                cascade();
+            fire(uint8_t(_now & mask));
+        }
+        _now = target;
+    }
+    //next tick with work: the next occupied level 0 slot or the next visit
+    //(cascade) of an occupied slot of an upper level, whichever comes first.
+    //Level k slot j is visited when the tick is a multiple of 2^(k*t_slotBits)
+    //with digit k equal to j, so empty turns are skipped in a single step
+    uint64_t nextEvent() const
+    {
+        uint64_t next = UINT64_MAX;
+        for( uint8_t level=0 ; level<t_levels ; level++ )
+        {
+            uint64_t occupied = _occupied[level];
+            if( occupied == 0 )
+                continue;
+            uint8_t shift = level*t_slotBits;
+            uint8_t idx = uint8_t((_now >> shift) & mask);
+            uint64_t turn = _now & ~((uint64_t(1) << (shift+t_slotBits)) - 1);
+            uint64_t bits = idx+1 < 64 ? occupied & (~uint64_t(0) << (idx+1)) : 0;
+            if( bits == 0 )
+            {
+                //only slots at or before the current one: next turn
+                bits = occupied;
+                turn += uint64_t(1) << (shift+t_slotBits);
+            }
+            uint64_t tick = turn + (uint64_t(std::countr_zero(bits)) << shift);
+            if( tick < next )
+                next = tick;
+        }
+        return next;
+    }
+    //moves the entries of the upper levels that are now in range to the
+    //lower levels (a level is only visited when the one below wrapped)
+    void cascade()
+    {
+        for( uint8_t level=1 ; level<t_levels ; level++ )
+        {
+            uint8_t idx = uint8_t((_now >> (level*t_slotBits)) & mask);
+            Entry* list = _slots[level][idx];
+            _slots[level][idx] = nullptr;
+            _occupied[level] &= ~(uint64_t(1) << idx);
+            while( list != nullptr )
+            {
+                Entry* e = list;
+                list = e->_next;
+                _active--;
+                insert(*e);
+            }
+            if( idx != 0 )
+                break;
+        }
+    }
+    void fire(uint8_t idx)
+    {
+        //entries of the current level 0 slot all expire now, callbacks may
+        //start or cancel any entry (new ones never land in this slot)
+        while( Entry* e = _slots[0][idx] )
+        {
+            unlink(*e);
+            if( e->_period != 0 )
+            {
+                e->_expires += e->_period;
+                insert(*e);
+            }
+            if( e->_callback != nullptr )
+                e->_callback(e->_arg);
+        }
+    }
+    void insert(Entry& e)
+    {
+        uint64_t diff = e._expires > _now ? e._expires - _now : 0;
+        uint8_t level = 0;
+        uint8_t idx = 0;
+        if( diff >= span )
+        {
+            //out of range: parked in the last slot of the last level turn
+            level = t_levels-1;
+            idx = uint8_t(((_now >> (level*t_slotBits)) + mask) & mask);
+        }
+        else
+        {
+            while( diff >= (uint64_t(1) << ((level+1)*t_slotBits)) )
+                level++;
+            idx = uint8_t(((diff != 0 ? e._expires : _now) >> (level*t_slotBits)) & mask);
+        }
+        Entry*& head = _slots[level][idx];
+        e._next = head;
+        if( head != nullptr )
+            head->_pprev = &e._next;
+        head = &e;
+        e._pprev = &head;
+        e._level = level;
+        e._slot  = idx;
+        _occupied[level] |= uint64_t(1) << idx;
+        _active++;
+    }
+    void unlink(Entry& e)
+    {
+        *e._pprev = e._next;
+        if( e._next != nullptr )
+            e._next->_pprev = e._pprev;
+        if( _slots[e._level][e._slot] == nullptr )
+            _occupied[e._level] &= ~(uint64_t(1) << e._slot);
+        e._next  = nullptr;
+        e._pprev = nullptr;
+        _active--;
+    }
+private:
+    std::array<std::array<Entry*,slots>,t_levels> _slots{};
+    std::array<uint64_t,t_levels> _occupied{};
+    uint64_t _now = 0;
+    t_TimerResolution _last;
+    size_t _active = 0;
+};
+
+}//namespace mcu
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+namespace mcu
+{
+
+/**
+ * Crc<T,t_poly,t_init,t_reflected,t_xorOut,t_table>
+ *
+ * Incremental CRC engine for CRC-8/16/32 (width = bits of T), parameters
+ * follow the usual catalog notation:
+ *  t_poly:      generator polynomial (normal, msb-first notation)
+ *  t_init:      initial value
+ *  t_reflected: refin = refout (true for lsb-first algorithms)
+ *  t_xorOut:    final xor
+ *
+ * t_table selects the speed/size trade-off (all tables are built at
+ * compile time and live in flash on MCUs):
+ *  bitwise: no table, 8 iterations per byte
+ *  nibble:  16 entries, 2 lookups per byte (default on MCUs)
+ *  byte:    256 entries, 1 lookup per byte
+ *  slice8:  8x256 entries, 8 bytes per iteration (default on hosts)
+ *
+ * The crc is serialized lsb first for reflected algorithms and msb first
+ * otherwise (byteAt()), so computing the crc over data+crc always gives
+ * the same residue and the frame can be checked in the same pass that
+ * receives it (check()).
+ *
+ * Example:
+ *  Crc32 crc;
+ *  crc.update(buff,len);
+ *  auto value = crc.value();
+ */
+enum class CrcTable : uint8_t
+{
+    bitwise,
+    nibble,
+    byte,
+    slice8
+};
+
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__) || defined(_M_X64)
+inline constexpr CrcTable crc_default_table = CrcTable::slice8;
+#else
+inline constexpr CrcTable crc_default_table = CrcTable::nibble;
+#endif
+
+template<typename T,
+         T        t_poly,
+         T        t_init,
+         bool     t_reflected,
+         T        t_xorOut,
+         CrcTable t_table = crc_default_table>
+class Crc
+{
+private:
+    static_assert(
+        std::is_same<T,std::uint8_t> ::value ||
+        std::is_same<T,std::uint16_t>::value ||
+        std::is_same<T,std::uint32_t>::value ,
+        "T must be one of: uint8_t, uint16_t or uint32_t");
+    static constexpr uint8_t width = sizeof(T)*8;
+    static constexpr T topBit = T(1) << (width-1);
+    static constexpr T reflect(T value)
+    {
+        T ret = 0;
+        for( uint8_t i=0 ; i<width ; i++ )
+            if( value & (T(1) << i) )
+                ret |= T(1) << (width-1-i);
+        return ret;
+    }
+    //polynomial and register are kept reflected for reflected algorithms
+    static constexpr T poly    = t_reflected ? reflect(t_poly) : t_poly;
+    static constexpr T regInit = t_reflected ? reflect(t_init) : t_init;
+    static constexpr T bitStep(T reg)
+    {
+        if constexpr ( t_reflected )
+            return (reg & 1) ? T((reg >> 1) ^ poly) : T(reg >> 1);
+        else
+            return (reg & topBit) ? T((reg << 1) ^ poly) : T(reg << 1);
+    }
+    static constexpr auto makeNibbleTable()
+    {
+        std::array<T,16> table{};
+        for( uint8_t i=0 ; i<16 ; i++ )
+        {
+            T reg = t_reflected ? T(i) : T(T(i) << (width-4));
+            for( uint8_t bit=0 ; bit<4 ; bit++ )
+                reg = bitStep(reg);
+            table[i] = reg;
+        }
+        return table;
+    }
+    static constexpr auto makeByteTable()
+    {
+        std::array<T,256> table{};
+        for( uint16_t i=0 ; i<256 ; i++ )
+        {
+            T reg = t_reflected ? T(i) : T(T(i) << (width-8));
+            for( uint8_t bit=0 ; bit<8 ; bit++ )
+                reg = bitStep(reg);
+            table[i] = reg;
+        }
+        return table;
+    }
+    static constexpr auto makeSlice8Table()
+    {
+        std::array<std::array<T,256>,8> table{};
+        table[0] = makeByteTable();
+        for( uint8_t k=1 ; k<8 ; k++ )
+            for( uint16_t i=0 ; i<256 ; i++ )
+            {
+                T prev = table[k-1][i];
+                if constexpr ( t_reflected )
+                    table[k][i] = T(prev >> 8) ^ table[0][prev & 0xFF];
+                else
+                    table[k][i] = T(prev << 8) ^ table[0][prev >> (width-8)];
+            }
+        return table;
+    }
+    static constexpr auto makeTable()
+    {
+        if constexpr ( t_table == CrcTable::nibble )
+            return makeNibbleTable();
+        else if constexpr ( t_table == CrcTable::byte )
+            return makeByteTable();
+        else if constexpr ( t_table == CrcTable::slice8 )
+            return makeSlice8Table();
+        else
+            return std::array<T,0>{};
+    }
+    static constexpr auto _table = makeTable();
+public:
+    using ValueType = T;
+    static constexpr size_t size = sizeof(T);
+public:
+    constexpr Crc() : _reg(regInit) {}
+    constexpr auto reset() -> void { _reg = regInit; }
+    constexpr auto update(uint8_t data) -> void
+    {
+        if constexpr ( t_table == CrcTable::bitwise )
+        {
+            if constexpr ( t_reflected )
+                _reg ^= data;
+            else
+                _reg ^= T(T(data) << (width-8));
+            for( uint8_t bit=0 ; bit<8 ; bit++ )
+                _reg = bitStep(_reg);
+        }
+        else if constexpr ( t_table == CrcTable::nibble )
+        {
+            if constexpr ( t_reflected )
+            {
+                _reg = T(_reg >> 4) ^ _table[(_reg ^ data) & 0x0F];
+                _reg = T(_reg >> 4) ^ _table[(_reg ^ (data >> 4)) & 0x0F];
+            }
+            else
+            {
+                _reg = T(_reg << 4) ^ _table[((_reg >> (width-4)) ^ (data >> 4)) & 0x0F];
+                _reg = T(_reg << 4) ^ _table[((_reg >> (width-4)) ^ data) & 0x0F];
+            }
+        }
+        else
+        {
+            const auto& table = byteTable();
+            if constexpr ( t_reflected )
+                _reg = T(_reg >> 8) ^ table[(_reg ^ data) & 0xFF];
+            else
+                _reg = T(_reg << 8) ^ table[((_reg >> (width-8)) ^ data) & 0xFF];
+        }
+    }
+    constexpr auto update(const uint8_t* data,size_t len) -> void
+    {
+        if constexpr ( t_table == CrcTable::slice8 )
+        {
+            for( ; len >= 8 ; len -= 8, data += 8 )
+                updateSlice8(data);
+        }
+        while( len-- )
+            update(*data++);
+    }
+    //finalized crc (for reflected algorithms the register already holds
+    //the reflected output)
+    constexpr auto value() const -> T
+    {
+        return T(_reg ^ t_xorOut);
+    }
+    //byte idx of the crc in transmission order
+    constexpr auto byteAt(size_t idx) const -> uint8_t
+    {
+        if constexpr ( t_reflected )
+            return uint8_t(value() >> (8*idx));
+        else
+            return uint8_t(value() >> (8*(size-1-idx)));
+    }
+    //true if the crc was computed over data followed by its crc (byteAt order)
+    constexpr auto check() const -> bool
+    {
+        constexpr T r = residue();
+        return value() == r;
+    }
+    static constexpr auto compute(const uint8_t* data,size_t len) -> T
+    {
+        Crc crc;
+        crc.update(data,len);
+        return crc.value();
+    }
+private:
+    static constexpr auto residue() -> T
+    {
+        Crc crc;
+        Crc aux = crc;
+        for( size_t idx=0 ; idx<size ; idx++ )
+            crc.update(aux.byteAt(idx));
+        return crc.value();
+    }
+    static constexpr auto byteTable() -> const std::array<T,256>&
+    {
+        if constexpr ( t_table == CrcTable::slice8 )
+            return _table[0];
+        else
+            return _table;
+    }
+    constexpr auto updateSlice8(const uint8_t* p) -> void
+    {
+        if constexpr ( t_reflected )
+        {
+            uint32_t lo = (uint32_t(p[0])      ) | (uint32_t(p[1]) <<  8) |
+                          (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+            uint32_t hi = (uint32_t(p[4])      ) | (uint32_t(p[5]) <<  8) |
+                          (uint32_t(p[6]) << 16) | (uint32_t(p[7]) << 24);
+            lo ^= _reg;
+            _reg = _table[7][ lo        & 0xFF] ^ _table[6][(lo >>  8) & 0xFF] ^
+                   _table[5][(lo >> 16) & 0xFF] ^ _table[4][ lo >> 24        ] ^
+                   _table[3][ hi        & 0xFF] ^ _table[2][(hi >>  8) & 0xFF] ^
+                   _table[1][(hi >> 16) & 0xFF] ^ _table[0][ hi >> 24        ];
+        }
+        else
+        {
+            uint32_t hi = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+                          (uint32_t(p[2]) <<  8) | (uint32_t(p[3])      );
+            uint32_t lo = (uint32_t(p[4]) << 24) | (uint32_t(p[5]) << 16) |
+                          (uint32_t(p[6]) <<  8) | (uint32_t(p[7])      );
+            hi ^= uint32_t(_reg) << (32-width);
+            _reg = _table[7][ hi >> 24        ] ^ _table[6][(hi >> 16) & 0xFF] ^
+                   _table[5][(hi >>  8) & 0xFF] ^ _table[4][ hi        & 0xFF] ^
+                   _table[3][ lo >> 24        ] ^ _table[2][(lo >> 16) & 0xFF] ^
+                   _table[1][(lo >>  8) & 0xFF] ^ _table[0][ lo        & 0xFF];
+        }
+    }
+private:
+    T _reg;
+};
+
+//no integrity check (default of mcu::Serial)
+struct NoCrc
+{
+    static constexpr size_t size = 0;
+    constexpr auto reset() -> void {}
+    constexpr auto update(uint8_t) -> void {}
+    constexpr auto update(const uint8_t*,size_t) -> void {}
+    constexpr auto byteAt(size_t) const -> uint8_t { return 0; }
+    constexpr auto check() const -> bool { return true; }
+};
+
+template<CrcTable t_table = crc_default_table>
+using Crc8_t        = Crc<uint8_t ,0x07      ,0x00      ,false,0x00      ,t_table>;  //CRC-8/SMBUS
+template<CrcTable t_table = crc_default_table>
+using Crc16Ccitt_t  = Crc<uint16_t,0x1021    ,0xFFFF    ,false,0x0000    ,t_table>;  //CRC-16/CCITT-FALSE
+template<CrcTable t_table = crc_default_table>
+using Crc16Modbus_t = Crc<uint16_t,0x8005    ,0xFFFF    ,true ,0x0000    ,t_table>;  //CRC-16/MODBUS
+template<CrcTable t_table = crc_default_table>
+using Crc32_t       = Crc<uint32_t,0x04C11DB7,0xFFFFFFFF,true ,0xFFFFFFFF,t_table>;  //CRC-32 (ethernet, zip)
+
+using Crc8        = Crc8_t<>;
+using Crc16Ccitt  = Crc16Ccitt_t<>;
+using Crc16Modbus = Crc16Modbus_t<>;
+using Crc32       = Crc32_t<>;
+
+}//namespace mcu
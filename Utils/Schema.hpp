@@ -0,0 +1,294 @@
+#pragma once
+
+#include "Serializer.hpp"
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace mcu
+{
+
+/**
+ * Compile-time record schemas (telemetry, logs): a Schema is a list of field
+ * descriptors, each one names a member of the record struct and how it is
+ * coded on the wire. Everything is resolved at compile time (fold
+ * expressions over the descriptors, no runtime reflection, no tables).
+ *
+ * Codings (FieldCoding):
+ *  raw:    fixed width, little endian (floats, values that use all the bits)
+ *  varint: unsigned LEB128, 7 bits per byte (small unsigned values)
+ *  zigzag: signed values mapped to unsigned (0,-1,1,-2...) then varint
+ *  bit:    bool packed in the flags bytes at the start of the record
+ * A varint/zigzag field can be delta coded: the difference with the same
+ * field of the previous record is sent (zigzag varint), so slowly changing
+ * values (counters, timestamps) take one byte.
+ *
+ * Wire format:
+ *  [flags: ceil(bits/8) bytes][fields in declaration order]
+ * If the schema has delta fields the first flag bit is the keyframe bit:
+ * set when the deltas are against zero (first record, after reset() or
+ * when requested). The decoder refuses delta records until it got a
+ * keyframe, so a lost record only costs the records until the next
+ * keyframe (send one periodically over lossy links).
+ *
+ * Example:
+ *  struct Sample { uint32_t time; int16_t temp; uint16_t adc; float v; bool alarm; bool door; };
+ *  using SampleSchema = mcu::Schema<
+ *      mcu::VarintField<&Sample::time,true>,   //delta
+ *      mcu::ZigzagField<&Sample::temp>,
+ *      mcu::VarintField<&Sample::adc>,
+ *      mcu::RawField<&Sample::v>,
+ *      mcu::BitField<&Sample::alarm>,
+ *      mcu::BitField<&Sample::door>>;
+ *  SampleSchema::Encoder enc;
+ *  std::array<uint8_t,SampleSchema::maxSize> buff;
+ *  auto len = enc.encode(sample,buff.data());
+ *  serial.txFrameAppend(buff.data(),len);
+ */
+enum class FieldCoding : uint8_t
+{
+    raw,
+    varint,
+    zigzag,
+    bit
+};
+
+namespace schema_detail
+{
+inline auto putVarint(uint8_t*& dst,uint64_t value) -> void
+{
+    while( value >= 0x80 )
+    {
+        *dst++ = uint8_t(value) | 0x80;
+        value >>= 7;
+    }
+    *dst++ = uint8_t(value);
+}
+inline auto getVarint(const uint8_t*& src,const uint8_t* end,uint64_t& value) -> bool
+{
+    value = 0;
+    for( uint8_t shift=0 ; shift<64 ; shift+=7 )
+    {
+        if( src == end )
+            return false;
+        uint8_t data = *src++;
+        value |= uint64_t(data & 0x7F) << shift;
+        if( (data & 0x80) == 0 )
+            return true;
+    }
+    return false;
+}
+constexpr auto zigzag(int64_t value) -> uint64_t { return (uint64_t(value) << 1) ^ uint64_t(value >> 63); }
+constexpr auto unzigzag(uint64_t value) -> int64_t { return int64_t(value >> 1) ^ -int64_t(value & 1); }
+}//namespace schema_detail
+
+template<auto t_member,FieldCoding t_coding,bool t_delta = false>
+struct Field
+{
+    using Record = typename serializer_detail::member_pointer_traits<decltype(t_member)>::class_type;
+    using Type   = typename serializer_detail::member_pointer_traits<decltype(t_member)>::value_type;
+    static constexpr FieldCoding coding = t_coding;
+    static constexpr bool delta = t_delta;
+    static constexpr bool isBit = t_coding == FieldCoding::bit;
+private:
+    static constexpr bool isVarint = t_coding == FieldCoding::varint || t_coding == FieldCoding::zigzag;
+    static_assert(!isBit || std::is_same_v<Type,bool>,"FieldCoding::bit needs a bool member");
+    static_assert(!isVarint || (std::is_integral_v<Type> && !std::is_same_v<Type,bool>),"varint/zigzag codings need an integral member");
+    static_assert(!t_delta || isVarint,"only varint/zigzag fields can be delta coded");
+    static_assert(t_coding != FieldCoding::raw || serializer_detail::is_wire_scalar<Type> || std::is_array_v<Type>,"raw fields must be scalars or arrays of scalars");
+public:
+    //worst case size on the wire (zigzag keeps the width of the type)
+    static constexpr size_t maxBytes = isBit ? 0 : isVarint ? (sizeof(Type)*8+6)/7 : sizeof(Type);
+
+    static auto encode(const Record& rec,const Record& prev,uint8_t*& dst) -> void
+    {
+        if constexpr ( t_coding == FieldCoding::raw )
+            dst = store(dst,rec.*t_member);
+        else if constexpr ( isVarint )
+        {
+            using U = std::make_unsigned_t<Type>;
+            using I = std::make_signed_t<Type>;
+            if constexpr ( t_delta )
+                schema_detail::putVarint(dst,schema_detail::zigzag(I(U(U(rec.*t_member) - U(prev.*t_member)))));
+            else if constexpr ( t_coding == FieldCoding::zigzag )
+                schema_detail::putVarint(dst,schema_detail::zigzag(int64_t(I(rec.*t_member))));
+            else
+                schema_detail::putVarint(dst,uint64_t(U(rec.*t_member)));
+        }
+    }
+    static auto decode(Record& rec,const Record& prev,const uint8_t*& src,const uint8_t* end) -> bool
+    {
+        if constexpr ( t_coding == FieldCoding::raw )
+        {
+            if( size_t(end-src) < sizeof(Type) )
+                return false;
+            if constexpr ( std::is_array_v<Type> )
+                src = load(rec.*t_member,src);
+            else
+            {
+                rec.*t_member = load<Type>(src);
+                src += sizeof(Type);
+            }
+            return true;
+        }
+        else if constexpr ( isVarint )
+        {
+            using U = std::make_unsigned_t<Type>;
+            uint64_t value = 0;
+            if( !schema_detail::getVarint(src,end,value) )
+                return false;
+            if constexpr ( t_delta )
+                rec.*t_member = Type(U(U(prev.*t_member) + U(schema_detail::unzigzag(value))));
+            else if constexpr ( t_coding == FieldCoding::zigzag )
+                rec.*t_member = Type(schema_detail::unzigzag(value));
+            else
+                rec.*t_member = Type(value);
+            return true;
+        }
+        else
+            return true;
+    }
+    static auto setBit(Record& rec,bool value) -> void
+    {
+        if constexpr ( isBit )
+            rec.*t_member = value;
+    }
+    static auto getBit(const Record& rec) -> bool
+    {
+        if constexpr ( isBit )
+            return rec.*t_member;
+        else
+            return false;
+    }
+};
+
+template<auto t_member>
+using RawField = Field<t_member,FieldCoding::raw>;
+template<auto t_member,bool t_delta = false>
+using VarintField = Field<t_member,FieldCoding::varint,t_delta>;
+template<auto t_member,bool t_delta = false>
+using ZigzagField = Field<t_member,FieldCoding::zigzag,t_delta>;
+template<auto t_member>
+using BitField = Field<t_member,FieldCoding::bit>;
+
+template<typename t_Field,typename... t_Fields>
+class Schema
+{
+public:
+    using Record = typename t_Field::Record;
+private:
+    static_assert((std::is_same_v<Record,typename t_Fields::Record> && ...),"all the fields must belong to the same record type");
+    static_assert(std::is_default_constructible_v<Record>,"the record type must be default constructible");
+    static constexpr bool hasDelta = t_Field::delta || (t_Fields::delta || ...);
+    static constexpr size_t flagBits = size_t(hasDelta) + size_t(t_Field::isBit) + (size_t(t_Fields::isBit) + ... + 0);
+public:
+    static constexpr size_t flagBytes = (flagBits+7)/8;
+    //worst case size of an encoded record
+    static constexpr size_t maxSize = flagBytes + t_Field::maxBytes + (t_Fields::maxBytes + ... + 0);
+
+    class Encoder
+    {
+    public:
+        //dst must have room for maxSize bytes, returns the encoded length
+        auto encode(const Record& rec,uint8_t* dst,bool keyframe = false) -> size_t
+        {
+            keyframe |= !_valid;
+            std::memset(dst,0,flagBytes);
+            uint8_t* ptr = dst + flagBytes;
+            size_t bit = 0;
+            if constexpr ( hasDelta )
+                putFlag(dst,bit,keyframe);
+            const Record& prev = keyframe ? zero() : _prev;
+            encodeField<t_Field>(rec,prev,dst,ptr,bit);
+            (encodeField<t_Fields>(rec,prev,dst,ptr,bit),...);
+            if constexpr ( hasDelta )
+            {
+                _prev = rec;
+                _valid = true;
+            }
+            return size_t(ptr - dst);
+        }
+        //the next record is a keyframe
+        auto reset() -> void { _valid = false; }
+    private:
+        template<typename F>
+        static auto encodeField(const Record& rec,const Record& prev,uint8_t* flags,uint8_t*& ptr,size_t& bit) -> void
+        {
+            if constexpr ( F::isBit )
+                putFlag(flags,bit,F::getBit(rec));
+            else
+                F::encode(rec,prev,ptr);
+        }
+        static auto putFlag(uint8_t* flags,size_t& bit,bool value) -> void
+        {
+            if( value )
+                flags[bit/8] |= uint8_t(1u << (bit%8));
+            bit++;
+        }
+    private:
+        Record _prev{};
+        bool   _valid = false;
+    };
+
+    class Decoder
+    {
+    public:
+        //false if the record is truncated or is a delta record and no
+        //keyframe was received yet (rec is undefined then)
+        auto decode(const uint8_t* src,size_t len,Record& rec) -> bool
+        {
+            if( len < flagBytes )
+                return false;
+            const uint8_t* end = src + len;
+            const uint8_t* ptr = src + flagBytes;
+            size_t bit = 0;
+            bool keyframe = false;
+            if constexpr ( hasDelta )
+            {
+                keyframe = getFlag(src,bit);
+                if( !keyframe && !_valid )
+                    return false;
+            }
+            const Record& prev = keyframe ? zero() : _prev;
+            bool ok = decodeField<t_Field>(rec,prev,src,ptr,end,bit);
+            ((ok = ok && decodeField<t_Fields>(rec,prev,src,ptr,end,bit)),...);
+            if constexpr ( hasDelta )
+            {
+                _valid = ok;
+                if( ok )
+                    _prev = rec;
+            }
+            return ok;
+        }
+        auto reset() -> void { _valid = false; }
+    private:
+        template<typename F>
+        static auto decodeField(Record& rec,const Record& prev,const uint8_t* flags,const uint8_t*& ptr,const uint8_t* end,size_t& bit) -> bool
+        {
+            if constexpr ( F::isBit )
+            {
+                F::setBit(rec,getFlag(flags,bit));
+                return true;
+            }
+            else
+                return F::decode(rec,prev,ptr,end);
+        }
+        static auto getFlag(const uint8_t* flags,size_t& bit) -> bool
+        {
+            bool value = (flags[bit/8] >> (bit%8)) & 1;
+            bit++;
+            return value;
+        }
+    private:
+        Record _prev{};
+        bool   _valid = false;
+    };
+private:
+    static auto zero() -> const Record&
+    {
+        static const Record record{};
+        return record;
+    }
+};
+
+}//namespace mcu
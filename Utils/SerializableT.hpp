@@ -1,6 +1,10 @@
 #pragma once
 #include <type_traits>
 #include <cstdint>
+#include <cstring>
+
+//kept for the existing code, new code should use Utils/Serializer.hpp
+//(explicit byte order, no type punning)
 
 template<typename T>
 union SerializableT
@@ -12,15 +16,11 @@ union SerializableT
     SerializableT(const uint8_t src[sizeof(T)]){ copyFrom(src); }
     bool operator==(const uint8_t raw[sizeof(T)]) const
     {
-        for( size_t idx=0 ; idx<sizeof(T) ; idx++ )
-            if( raw[idx] != this->raw[idx] )
-                return false;
-        return true;
+        return std::memcmp(raw,this->raw,sizeof(T)) == 0;
     }
     void copyFrom(const uint8_t src[sizeof(T)])
     {
-        for( size_t idx=0 ; idx<sizeof(T) ; idx++ )
-            raw[idx] = src[idx];
+        std::memcpy(raw,src,sizeof(T));
     }
     constexpr size_t size() const
     {
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace mcu
+{
+
+/**
+ * Bulk serialization with an explicit byte order (std::endian::little by
+ * default, the order used on the wire by most MCUs).
+ *
+ *  toBytes<endian>(value)    -> std::array<uint8_t,sizeof(value)>
+ *  fromBytes<T,endian>(src)  -> T
+ *  store<endian>(dst,value)  -> dst + sizeof(value)
+ *  load<T,endian>(src)       -> T
+ *
+ * value can be any scalar (integers, floats, enums) or an array of scalars.
+ * The bytes are moved with std::bit_cast/memcpy (no type punning), when the
+ * requested order is the native one an array is copied with a single memcpy,
+ * otherwise each element is byte swapped (bswap/rev instructions).
+ *
+ * Layout<&S::a,&S::b,...> describes the wire format of a struct at compile
+ * time: the members are stored one after the other (packed, no padding bytes
+ * are sent) in the given order, encode()/decode() are unrolled at compile
+ * time (no per-field loop, no runtime reflection).
+ *
+ * Example:
+ *  struct Telemetry { uint32_t time; int16_t temp; float v[3]; };
+ *  using TelemetryLayout = mcu::Layout<&Telemetry::time,&Telemetry::temp,&Telemetry::v>;
+ *  std::array<uint8_t,TelemetryLayout::size> frame;   //18 bytes, sizeof(Telemetry) is 20
+ *  TelemetryLayout::encode(t,frame.data());
+ *  serial.txFrameAppend(frame.data(),frame.size());
+ */
+
+template<typename T>
+constexpr auto byteswap(T value) -> T
+{
+    static_assert(std::is_integral_v<T>,"T must be an integral type");
+    if constexpr ( sizeof(T) == 1 )
+        return value;
+#if defined(__GNUC__)
+    else if constexpr ( sizeof(T) == 2 )
+        return T(__builtin_bswap16(uint16_t(value)));
+    else if constexpr ( sizeof(T) == 4 )
+        return T(__builtin_bswap32(uint32_t(value)));
+    else if constexpr ( sizeof(T) == 8 )
+        return T(__builtin_bswap64(uint64_t(value)));
+#endif
+    else
+    {
+        auto raw = std::bit_cast<std::array<uint8_t,sizeof(T)>>(value);
+        std::reverse(raw.begin(),raw.end());
+        return std::bit_cast<T>(raw);
+    }
+}
+
+namespace serializer_detail
+{
+template<size_t t_size> struct uint_of_size {};
+template<> struct uint_of_size<1> { using type = uint8_t;  };
+template<> struct uint_of_size<2> { using type = uint16_t; };
+template<> struct uint_of_size<4> { using type = uint32_t; };
+template<> struct uint_of_size<8> { using type = uint64_t; };
+
+template<typename T>
+inline constexpr bool is_wire_scalar = std::is_scalar_v<T> && !std::is_pointer_v<T> && !std::is_member_pointer_v<T>;
+
+//scalar in the requested byte order (as raw unsigned bits)
+template<std::endian t_endian,typename T>
+constexpr auto toWire(T value)
+{
+    using U = typename uint_of_size<sizeof(T)>::type;
+    U bits = std::bit_cast<U>(value);
+    if constexpr ( t_endian != std::endian::native )
+        bits = byteswap(bits);
+    return bits;
+}
+
+template<typename T,std::endian t_endian>
+constexpr auto fromWire(typename uint_of_size<sizeof(T)>::type bits) -> T
+{
+    if constexpr ( t_endian != std::endian::native )
+        bits = byteswap(bits);
+    return std::bit_cast<T>(bits);
+}
+
+template<typename>
+struct member_pointer_traits;
+template<typename C,typename M>
+struct member_pointer_traits<M C::*>
+{
+    using class_type = C;
+    using value_type = M;
+};
+}//namespace serializer_detail
+
+template<std::endian t_endian = std::endian::little,typename T>
+auto store(uint8_t* dst,const T& value) -> uint8_t*
+{
+    if constexpr ( std::is_array_v<T> )
+    {
+        using E = std::remove_extent_t<T>;
+        static_assert(serializer_detail::is_wire_scalar<E>,"arrays must hold scalars");
+        if constexpr ( t_endian == std::endian::native || sizeof(E) == 1 )
+        {
+            std::memcpy(dst,&value,sizeof(T));
+            return dst + sizeof(T);
+        }
+        else
+        {
+            for( const auto& item : value )
+                dst = store<t_endian>(dst,item);
+            return dst;
+        }
+    }
+    else
+    {
+        static_assert(serializer_detail::is_wire_scalar<T>,"T must be a scalar (use mcu::Layout for structs)");
+        auto bits = serializer_detail::toWire<t_endian>(value);
+        std::memcpy(dst,&bits,sizeof(T));
+        return dst + sizeof(T);
+    }
+}
+
+template<typename T,std::endian t_endian = std::endian::little>
+auto load(const uint8_t* src) -> T
+{
+    static_assert(serializer_detail::is_wire_scalar<T>,"T must be a scalar (use mcu::Layout for structs)");
+    typename serializer_detail::uint_of_size<sizeof(T)>::type bits;
+    std::memcpy(&bits,src,sizeof(T));
+    return serializer_detail::fromWire<T,t_endian>(bits);
+}
+
+//loads an array of scalars (one memcpy when the order is the native one)
+template<std::endian t_endian = std::endian::little,typename T,size_t N>
+auto load(T (&dst)[N],const uint8_t* src) -> const uint8_t*
+{
+    static_assert(serializer_detail::is_wire_scalar<T>,"arrays must hold scalars");
+    if constexpr ( t_endian == std::endian::native || sizeof(T) == 1 )
+        std::memcpy(dst,src,sizeof(dst));
+    else
+        for( size_t idx=0 ; idx<N ; idx++ )
+            dst[idx] = load<T,t_endian>(src + idx*sizeof(T));
+    return src + sizeof(dst);
+}
+
+template<std::endian t_endian = std::endian::little,typename T>
+constexpr auto toBytes(const T& value) -> std::array<uint8_t,sizeof(T)>
+{
+    static_assert(serializer_detail::is_wire_scalar<T>,"T must be a scalar (use mcu::Layout for structs)");
+    return std::bit_cast<std::array<uint8_t,sizeof(T)>>(serializer_detail::toWire<t_endian>(value));
+}
+
+template<typename T,std::endian t_endian = std::endian::little>
+constexpr auto fromBytes(const std::array<uint8_t,sizeof(T)>& raw) -> T
+{
+    using U = typename serializer_detail::uint_of_size<sizeof(T)>::type;
+    return serializer_detail::fromWire<T,t_endian>(std::bit_cast<U>(raw));
+}
+
+//copies len bytes into the two spans returned by FifoRaw::reserve()
+//(at most two memcpy, whatever the position of the ring head)
+inline auto scatter(const std::pair<std::span<uint8_t>,std::span<uint8_t>>& dst,const uint8_t* src,size_t len) -> size_t
+{
+    size_t first = std::min(len,dst.first.size());
+    std::memcpy(dst.first.data(),src,first);
+    size_t second = std::min(len-first,dst.second.size());
+    std::memcpy(dst.second.data(),src+first,second);
+    return first + second;
+}
+
+template<auto... t_members>
+struct Layout
+{
+private:
+    template<auto t_member>
+    using member_t = typename serializer_detail::member_pointer_traits<decltype(t_member)>::value_type;
+    static_assert(sizeof...(t_members) > 0,"a layout needs at least one member");
+public:
+    //wire size (packed)
+    static constexpr size_t size = (sizeof(member_t<t_members>) + ...);
+
+    template<std::endian t_endian = std::endian::little,typename S>
+    static auto encode(const S& src,uint8_t* dst) -> uint8_t*
+    {
+        ((dst = store<t_endian>(dst,src.*t_members)),...);
+        return dst;
+    }
+    template<std::endian t_endian = std::endian::little,typename S>
+    static auto decode(S& dst,const uint8_t* src) -> const uint8_t*
+    {
+        (decodeMember<t_members,t_endian>(dst,src),...);
+        return src;
+    }
+    template<std::endian t_endian = std::endian::little,typename S>
+    static auto toBytes(const S& src) -> std::array<uint8_t,size>
+    {
+        std::array<uint8_t,size> raw;
+        encode<t_endian>(src,raw.data());
+        return raw;
+    }
+private:
+    template<auto t_member,std::endian t_endian,typename S>
+    static auto decodeMember(S& dst,const uint8_t*& src) -> void
+    {
+        using M = member_t<t_member>;
+        if constexpr ( std::is_array_v<M> )
+            src = load<t_endian>(dst.*t_member,src);
+        else
+        {
+            dst.*t_member = load<M,t_endian>(src);
+            src += sizeof(M);
+        }
+    }
+};
+
+}//namespace mcu
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <new>
 #include <type_traits>
 
 namespace mcu
@@ -68,6 +70,102 @@ namespace mcu
     consteval T max_val_storable_on(){ return static_cast<fit_value_t<T>>(~size_t(0)); }
 #endif
 
+/**
+ * fast_combinations_t<N> / fast_value_t<N>
+ *
+ * Like fit_combinations_t/fit_value_t but never narrower than unsigned int,
+ * so index arithmetic works on whole registers (no partial register writes
+ * and zero extensions on x86). uint_fast8_t/uint_fast16_t are not used
+ * directly: uint_fast8_t is still 8 bits wide on the common ABIs.
+ * Examples:
+ *      fast_combinations_t<256> x; //x is of type unsigned int
+ *      fast_value_t<1ull<<40> x;   //x is of type uint64_t
+ *
+ *
+ * StoragePolicy
+ *
+ * Size-vs-speed layout of the containers (FifoBuffer, FifoRaw, VLItemFifo,
+ * CircularSpan):
+ *      size:  smallest index types (fit_combinations_t), no padding
+ *      speed: fast index types (fast_combinations_t), the buffer starts on a
+ *             cache line
+ * default_storage_policy is size: the layout of the existing containers does
+ * not change, speed is chosen per instance (last template parameter), for
+ * instance VLItemFifo<...,StoragePolicy::speed> on a host.
+ *
+ * index_t<N,policy>
+ *
+ * Alias the index type able to address N items with the given policy.
+ *
+ *
+ * destructive_interference_size / constructive_interference_size
+ *
+ * std::hardware_destructive_interference_size and
+ * std::hardware_constructive_interference_size when the standard library has
+ * them, 64 otherwise. The std values depend on the compiler and the tuning
+ * flags (gcc warns when they are used in a header), define
+ * MCU_CACHE_LINE_SIZE to pin both values.
+ *
+ *
+ * CachePadded<T>
+ *
+ * T alone on its own cache line(s), to keep data written by different cores
+ * (producer/consumer indexes, per thread counters) out of each other's lines.
+ *
+ *
+ * storage_align_v<T,policy>
+ *
+ * Alignment of a T member in a container with the given policy: alignof(T)
+ * for size, at least a cache line for speed.
+ */
+template<uint64_t N>
+using fast_combinations_t = std::conditional_t<(sizeof(fit_combinations_t<N>) < sizeof(unsigned)),unsigned,fit_combinations_t<N>>;
+template<uint64_t N>
+using fast_value_t = std::conditional_t<(sizeof(fit_value_t<N>) < sizeof(unsigned)),unsigned,fit_value_t<N>>;
+
+enum class StoragePolicy : uint8_t
+{
+    size,
+    speed
+};
+
+inline constexpr StoragePolicy default_storage_policy = StoragePolicy::size;
+
+template<uint64_t N,StoragePolicy t_policy>
+using index_t = std::conditional_t<t_policy == StoragePolicy::speed,fast_combinations_t<N>,fit_combinations_t<N>>;
+
+#if defined(MCU_CACHE_LINE_SIZE)
+    inline constexpr size_t destructive_interference_size  = MCU_CACHE_LINE_SIZE;
+    inline constexpr size_t constructive_interference_size = MCU_CACHE_LINE_SIZE;
+#elif defined(__cpp_lib_hardware_interference_size)
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Winterference-size"
+    #endif
+    inline constexpr size_t destructive_interference_size  = std::hardware_destructive_interference_size;
+    inline constexpr size_t constructive_interference_size = std::hardware_constructive_interference_size;
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic pop
+    #endif
+#else
+    inline constexpr size_t destructive_interference_size  = 64;
+    inline constexpr size_t constructive_interference_size = 64;
+#endif
+
+template<typename T>
+struct alignas(destructive_interference_size) CachePadded
+{
+    T value;
+    T& operator*() { return value; }
+    const T& operator*() const { return value; }
+    T* operator->() { return &value; }
+    const T* operator->() const { return &value; }
+};
+
+template<typename T,StoragePolicy t_policy>
+inline constexpr size_t storage_align_v = t_policy == StoragePolicy::speed && alignof(T) < destructive_interference_size ?
+                                          destructive_interference_size : alignof(T);
+
 //credits to https://stackoverflow.com/a/28796458/2538072
 template<typename Test, template<typename...> class Ref>
 struct is_specialization : std::false_type {};
@@ -0,0 +1,265 @@
+#pragma once
+//Minimal benchmark runner for the host benchmarks, writing the JSON format of
+//Google Benchmark (--benchmark_format=json), so that the files can be compared
+//with its tools/compare.py:
+//  {"context":{...},"benchmarks":[{"name","iterations","real_time","cpu_time",
+//   "time_unit":"ns",counters...},...]}
+//The times are per iteration, of the fastest of the repetitions (on a shared
+//host the noise only adds time). Counters, when the benchmark gives the work
+//per iteration: items_per_second, bytes_per_second, ns_per_item, gflops,
+//mac_per_second and, on x86, bytes_per_cycle (cycles of the TSC).
+//Arguments: --out=FILE (default stdout), --filter=SUBSTRING, --quick (one
+//short repetition, a smoke test of the benchmark).
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace mcu_bench
+{
+
+//keeps the compiler from optimizing away a result or the stores to memory
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobberMemory()
+{
+    asm volatile("" : : : "memory");
+}
+
+inline auto cycles() -> uint64_t
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+//work done by one iteration, for the rate counters (0: not reported)
+struct Work
+{
+    double items = 0;
+    double bytes = 0;
+    double flops = 0;
+    double macs  = 0;
+};
+
+class Runner
+{
+public:
+    Runner(int argc,char** argv)
+        : _executable(argc > 0 ? argv[0] : "")
+    {
+        for( int i=1 ; i<argc ; i++ )
+        {
+            std::string_view arg(argv[i]);
+            if( arg == "--quick" )
+                _quick = true;
+            else if( arg.starts_with("--out=") )
+                _out = arg.substr(6);
+            else if( arg.starts_with("--filter=") )
+                _filter = arg.substr(9);
+            else
+                std::fprintf(stderr,"%s: unknown argument %s\n",_executable.c_str(),argv[i]);
+        }
+    }
+
+    auto quick() const -> bool { return _quick; }
+
+    //extra "context" entry (variant, instruction set...)
+    void context(std::string key,std::string value)
+    {
+        _context.emplace_back(std::move(key),std::move(value));
+    }
+
+    //times f(), called repeatedly, and records one benchmark
+    template<typename t_Function>
+    void run(const std::string& name,const Work& work,t_Function&& f)
+    {
+        if( !_filter.empty() && name.find(_filter) == std::string::npos )
+            return;
+        const double minTime_ns = _quick ? 0 : 20e6;
+        const int repetitions = _quick ? 1 : 5;
+        //iterations per repetition: grow until one repetition lasts minTime_ns
+        uint64_t iterations = 1;
+        Sample sample = measure(iterations,f);
+        while( sample.real_ns < minTime_ns && iterations < (uint64_t(1) << 40) )
+        {
+            double factor = sample.real_ns > 0 ? 1.4*minTime_ns/sample.real_ns : 10;
+            iterations = std::max<uint64_t>(iterations+1,uint64_t(double(iterations)*std::min(factor,10.0)));
+            sample = measure(iterations,f);
+        }
+        for( int r=1 ; r<repetitions ; r++ )
+        {
+            Sample next = measure(iterations,f);
+            if( next.real_ns < sample.real_ns )
+                sample = next;
+        }
+        Result result{name,iterations,sample.real_ns/double(iterations),sample.cpu_ns/double(iterations),
+                      double(sample.cycles)/double(iterations),work};
+        _results.push_back(result);
+    }
+
+    //writes the JSON report, returns the exit code of main()
+    auto finish() -> int
+    {
+        FILE* file = _out.empty() ? stdout : std::fopen(_out.c_str(),"w");
+        if( file == nullptr )
+        {
+            std::perror(_out.c_str());
+            return 1;
+        }
+        writeJson(file);
+        if( file != stdout )
+            std::fclose(file);
+        return 0;
+    }
+
+private:
+    struct Sample
+    {
+        double   real_ns;
+        double   cpu_ns;
+        uint64_t cycles;
+    };
+
+    struct Result
+    {
+        std::string name;
+        uint64_t    iterations;
+        double      real_ns;
+        double      cpu_ns;
+        double      cycles;
+        Work        work;
+    };
+
+    static auto cpuTime_ns() -> double
+    {
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID,&ts);
+        return double(ts.tv_sec)*1e9+double(ts.tv_nsec);
+    }
+
+    template<typename t_Function>
+    static auto measure(uint64_t iterations,t_Function& f) -> Sample
+    {
+        double cpu0 = cpuTime_ns();
+        auto t0 = std::chrono::steady_clock::now();
+        uint64_t c0 = cycles();
+        for( uint64_t i=0 ; i<iterations ; i++ )
+            f();
+        uint64_t c1 = cycles();
+        auto t1 = std::chrono::steady_clock::now();
+        double cpu1 = cpuTime_ns();
+        return {std::chrono::duration<double,std::nano>(t1-t0).count(),cpu1-cpu0,c1-c0};
+    }
+
+    static void writeString(FILE* file,std::string_view str)
+    {
+        std::fputc('"',file);
+        for( char ch : str )
+        {
+            if( ch == '"' || ch == '\\' )
+                std::fprintf(file,"\\%c",ch);
+            else if( uint8_t(ch) < 0x20 )
+                std::fprintf(file,"\\u%04x",unsigned(ch));
+            else
+                std::fputc(ch,file);
+        }
+        std::fputc('"',file);
+    }
+
+    void writeJson(FILE* file) const
+    {
+        char date[64];
+        time_t now = time(nullptr);
+        strftime(date,sizeof(date),"%Y-%m-%dT%H:%M:%S%z",localtime(&now));
+        char host[256] = "";
+        gethostname(host,sizeof(host)-1);
+        std::fprintf(file,"{\n  \"context\": {\n    \"date\": ");
+        writeString(file,date);
+        std::fprintf(file,",\n    \"host_name\": ");
+        writeString(file,host);
+        std::fprintf(file,",\n    \"executable\": ");
+        writeString(file,_executable);
+        std::fprintf(file,",\n    \"num_cpus\": %u,\n    \"mhz_per_cpu\": %.0f,\n    \"cpu_scaling_enabled\": false,\n",
+                     std::thread::hardware_concurrency(),tscMhz());
+#ifdef NDEBUG
+        std::fprintf(file,"    \"library_build_type\": \"release\"");
+#else
+        std::fprintf(file,"    \"library_build_type\": \"debug\"");
+#endif
+        for( auto& [key,value] : _context )
+        {
+            std::fprintf(file,",\n    ");
+            writeString(file,key);
+            std::fprintf(file,": ");
+            writeString(file,value);
+        }
+        std::fprintf(file,"\n  },\n  \"benchmarks\": [");
+        for( size_t i=0 ; i<_results.size() ; i++ )
+        {
+            auto& r = _results[i];
+            std::fprintf(file,"%s\n    {\n      \"name\": ",i == 0 ? "" : ",");
+            writeString(file,r.name);
+            std::fprintf(file,",\n      \"run_name\": ");
+            writeString(file,r.name);
+            std::fprintf(file,",\n      \"run_type\": \"iteration\",\n      \"repetitions\": 1,\n      \"repetition_index\": 0,\n"
+                              "      \"threads\": 1,\n      \"iterations\": %llu,\n      \"real_time\": %.6g,\n"
+                              "      \"cpu_time\": %.6g,\n      \"time_unit\": \"ns\"",
+                         (unsigned long long)r.iterations,r.real_ns,r.cpu_ns);
+            double seconds = r.real_ns*1e-9;
+            if( r.work.items > 0 )
+                std::fprintf(file,",\n      \"items_per_second\": %.6g,\n      \"ns_per_item\": %.6g",
+                             r.work.items/seconds,r.real_ns/r.work.items);
+            if( r.work.bytes > 0 )
+            {
+                std::fprintf(file,",\n      \"bytes_per_second\": %.6g",r.work.bytes/seconds);
+                if( r.cycles > 0 )
+                    std::fprintf(file,",\n      \"bytes_per_cycle\": %.6g",r.work.bytes/r.cycles);
+            }
+            if( r.work.flops > 0 )
+                std::fprintf(file,",\n      \"gflops\": %.6g",r.work.flops/r.real_ns);
+            if( r.work.macs > 0 )
+                std::fprintf(file,",\n      \"mac_per_second\": %.6g",r.work.macs/seconds);
+            std::fprintf(file,"\n    }");
+        }
+        std::fprintf(file,"\n  ]\n}\n");
+    }
+
+    //TSC rate, from the results already measured (0 without a TSC)
+    auto tscMhz() const -> double
+    {
+        double cyclesSum = 0, nsSum = 0;
+        for( auto& r : _results )
+        {
+            cyclesSum += r.cycles*double(r.iterations);
+            nsSum += r.real_ns*double(r.iterations);
+        }
+        return nsSum > 0 ? cyclesSum/nsSum*1e3 : 0;
+    }
+
+    std::string _executable;
+    std::string _out;
+    std::string _filter;
+    bool        _quick = false;
+    std::vector<std::pair<std::string,std::string>> _context;
+    std::vector<Result> _results;
+};
+
+}//namespace mcu_bench
@@ -0,0 +1,32 @@
+//cost of mcu::Timer::elapsed() on each of the PC clock sources
+#include "Bench.hpp"
+#include "../Timer/PC/TimerImp.hpp"
+
+namespace
+{
+
+template<typename t_Timer>
+void elapsedBench(mcu_bench::Runner& bench,const std::string& name)
+{
+    t_Timer timer;
+    bench.run("elapsed/"+name,{.items = 1},[&]
+    {
+        mcu_bench::doNotOptimize(timer.elapsed().count());
+    });
+}
+
+}//namespace
+
+int main(int argc,char** argv)
+{
+    mcu_bench::Runner bench(argc,argv);
+    elapsedBench<Tim64_us>(bench,"system_clock");
+    elapsedBench<Tim64_steady_us>(bench,"steady_clock");
+    elapsedBench<Tim64_coarse_ms>(bench,"coarse");
+#if defined(__x86_64__) || defined(__i386__)
+    elapsedBench<Tim64_tsc_us>(bench,"tsc");
+#endif
+    TickCache64_us::update();
+    elapsedBench<Tim64_cached_us>(bench,"cached");
+    return bench.finish();
+}
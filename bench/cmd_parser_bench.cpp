@@ -0,0 +1,55 @@
+//mcu::CmdParser: one command with three arguments, pushed and executed, in
+//text and in binary mode
+#include "Bench.hpp"
+#include "../Comm/CmdParser.h"
+
+using namespace mcu;
+
+namespace
+{
+
+using Args = VLItemLifo<64>;
+
+long argsSeen = 0;
+
+CmdParserRetType count(Args& args)
+{
+    argsSeen += args.itemsCount();
+    return CmdParserRetType::finished_ok;
+}
+
+constexpr std::array<std::pair<std::string_view,CmdParserRetType(*)(Args&)>,3> commands{{{"get",count},{"status",count},{"set_value",count}}};
+
+template<typename t_Parser>
+void parserBench(mcu_bench::Runner& bench,const std::string& name,const std::vector<uint8_t>& command)
+{
+    t_Parser parser;
+    parser.start();
+    bench.run(name,{.items = 1,.bytes = double(command.size())},[&]
+    {
+        size_t idx = 0;
+        while( idx < command.size() )
+        {
+            while( idx < command.size() && parser.rxFreeSpace() )
+                parser.pushData(command[idx++]);
+            parser();
+        }
+        //text mode scans one byte per call
+        while( parser.hasWork() )
+            parser();
+    });
+}
+
+}//namespace
+
+int main(int argc,char** argv)
+{
+    mcu_bench::Runner bench(argc,argv);
+    std::string text = "set_value 12 -3456 789012\r";
+    //varint length, command id 2, then the three length prefixed arguments
+    std::vector<uint8_t> binary = {11,2,1,12,2,0xC0,0xF2,3,0x14,0x0C,0x0C};
+    parserBench<CmdParser<' ','\r',64,3,commands>>(bench,"cmd_parser/text",{text.begin(),text.end()});
+    parserBench<CmdParser<' ','\r',64,3,commands,1,1,CmdParserMode::binary>>(bench,"cmd_parser/binary",binary);
+    mcu_bench::doNotOptimize(argsSeen);
+    return bench.finish();
+}
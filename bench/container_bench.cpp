@@ -0,0 +1,93 @@
+//FifoBuffer, FifoRaw and VLItemFifo with the size and the speed storage
+//policies: fill, scan and drain
+#include "Bench.hpp"
+#include "../Container/FifoBuffer.hpp"
+#include "../Container/VLItemFifo.h"
+
+using namespace mcu;
+
+namespace
+{
+
+constexpr const char* policyName(StoragePolicy policy)
+{
+    return policy == StoragePolicy::speed ? "speed" : "size";
+}
+
+//150 bytes in a 200 byte fifo: put, read by index, get
+template<StoragePolicy t_policy>
+void fifoBench(mcu_bench::Runner& bench)
+{
+    static FifoBuffer<uint8_t,200,false,t_policy> fifo;
+    uint8_t round = 0;
+    bench.run(std::string("FifoBuffer/150/")+policyName(t_policy),{.items = 150},[&]
+    {
+        uint32_t sum = 0;
+        for( int i=0 ; i<150 ; i++ )
+            fifo.put(uint8_t(i+round));
+        for( unsigned i=0 ; i<fifo.length() ; i++ )
+            sum += fifo[i];
+        while( !fifo.isEmpty() )
+            sum += fifo.get();
+        round++;
+        mcu_bench::doNotOptimize(sum);
+    });
+}
+
+template<StoragePolicy t_policy>
+void rawBench(mcu_bench::Runner& bench)
+{
+    static FifoRaw<uint8_t,200,false,t_policy> fifo;
+    uint8_t round = 0;
+    bench.run(std::string("FifoRaw/150/")+policyName(t_policy),{.items = 150},[&]
+    {
+        uint32_t sum = 0;
+        for( int i=0 ; i<150 ; i++ )
+            fifo.put(uint8_t(i+round));
+        for( unsigned i=0 ; i<fifo.length() ; i++ )
+            sum += fifo.getDataAtRelativeIdx(i);
+        while( !fifo.isEmpty() )
+            sum += fifo.get();
+        round++;
+        mcu_bench::doNotOptimize(sum);
+    });
+}
+
+//10 items of three uint32_t
+template<StoragePolicy t_policy>
+void itemsBench(mcu_bench::Runner& bench)
+{
+    static VLItemFifo<uint8_t,200,200,t_policy> fifo;
+    uint32_t round = 0;
+    bench.run(std::string("VLItemFifo/10x12/")+policyName(t_policy),{.items = 10},[&]
+    {
+        uint32_t sum = 0;
+        for( int k=0 ; k<10 ; k++ )
+        {
+            for( uint32_t i=0 ; i<3 ; i++ )
+                fifo.push(i+round);
+            fifo.commitItem();
+        }
+        auto span = fifo.getCircularSpan();
+        for( unsigned i=0 ; i<span.size() ; i++ )
+            sum += span[i];
+        while( fifo.itemsCount() )
+            fifo.pop();
+        round++;
+        mcu_bench::doNotOptimize(sum);
+    });
+}
+
+}//namespace
+
+int main(int argc,char** argv)
+{
+    mcu_bench::Runner bench(argc,argv);
+    fifoBench<StoragePolicy::size>(bench);
+    fifoBench<StoragePolicy::speed>(bench);
+    rawBench<StoragePolicy::size>(bench);
+    rawBench<StoragePolicy::speed>(bench);
+    itemsBench<StoragePolicy::size>(bench);
+    itemsBench<StoragePolicy::speed>(bench);
+    return bench.finish();
+}
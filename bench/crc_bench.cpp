@@ -0,0 +1,38 @@
+//mcu::Crc throughput of every table strategy, on 4KiB blocks
+#include "Bench.hpp"
+#include "../Utils/Crc.hpp"
+
+using namespace mcu;
+
+namespace
+{
+
+template<typename t_Crc>
+void crcBench(mcu_bench::Runner& bench,const std::string& name)
+{
+    static std::vector<uint8_t> data(4096,0x5A);
+    bench.run(name+"/4096",{.items = double(data.size()),.bytes = double(data.size())},[&]
+    {
+        mcu_bench::doNotOptimize(t_Crc::compute(data.data(),data.size()));
+    });
+}
+
+template<template<CrcTable> class t_Crc>
+void tablesBench(mcu_bench::Runner& bench,const std::string& name)
+{
+    crcBench<t_Crc<CrcTable::bitwise>>(bench,name+"/bitwise");
+    crcBench<t_Crc<CrcTable::nibble>>(bench,name+"/nibble");
+    crcBench<t_Crc<CrcTable::byte>>(bench,name+"/byte");
+    crcBench<t_Crc<CrcTable::slice8>>(bench,name+"/slice8");
+}
+
+}//namespace
+
+int main(int argc,char** argv)
+{
+    mcu_bench::Runner bench(argc,argv);
+    tablesBench<Crc8_t>(bench,"crc8");
+    tablesBench<Crc16Ccitt_t>(bench,"crc16_ccitt");
+    tablesBench<Crc32_t>(bench,"crc32");
+    return bench.finish();
+}
@@ -0,0 +1,310 @@
+//CMSIS-DSP functions of one cmsisdsp_<variant> library (MCU_DSP_VARIANT), one
+//or two per family, on the block sizes of typical uses. With the dispatch
+//variant the dispatched functions are run once per instruction set.
+#include "Bench.hpp"
+#include "arm_math.h"
+#include "arm_const_structs.h"
+#if defined(ARM_MATH_X86_DISPATCH)
+#include "arm_dispatch_x86.h"
+#endif
+#include <cmath>
+
+namespace
+{
+
+constexpr uint32_t sizes[] = {64,256,1024,4096};
+constexpr uint32_t maxSize = 4096;
+
+using mcu_bench::Work;
+
+//inputs in [-0.5,0.5), q15 and q7 copies, and the outputs
+struct Buffers
+{
+    std::vector<float32_t> a = std::vector<float32_t>(2*maxSize), b = a, out = a, out2 = a;
+    std::vector<q31_t> a31 = std::vector<q31_t>(2*maxSize), b31 = a31, out31 = a31;
+    std::vector<q15_t> a15 = std::vector<q15_t>(2*maxSize), b15 = a15, out15 = a15;
+    std::vector<q7_t> a7 = std::vector<q7_t>(2*maxSize), b7 = a7, out7 = a7;
+
+    Buffers()
+    {
+        for( size_t i=0 ; i<a.size() ; i++ )
+        {
+            a[i] = float32_t(std::sin(0.37*double(i)))*0.5f;
+            b[i] = float32_t(std::cos(0.11*double(i)))*0.5f;
+        }
+        arm_float_to_q31(a.data(),a31.data(),uint32_t(a.size()));
+        arm_float_to_q31(b.data(),b31.data(),uint32_t(b.size()));
+        arm_float_to_q15(a.data(),a15.data(),uint32_t(a.size()));
+        arm_float_to_q15(b.data(),b15.data(),uint32_t(b.size()));
+        arm_float_to_q7(a.data(),a7.data(),uint32_t(a.size()));
+        arm_float_to_q7(b.data(),b7.data(),uint32_t(b.size()));
+    }
+};
+
+auto sized(const char* name,uint32_t n) -> std::string
+{
+    return std::string(name)+"/"+std::to_string(n);
+}
+
+//elementwise: bytes = two inputs and one output
+void basicBench(mcu_bench::Runner& bench,Buffers& buf)
+{
+    for( uint32_t n : sizes )
+    {
+        bench.run(sized("arm_add_f32",n),{.items = double(n),.bytes = 12.0*n,.flops = double(n)},[&]
+        { arm_add_f32(buf.a.data(),buf.b.data(),buf.out.data(),n); mcu_bench::clobberMemory(); });
+        bench.run(sized("arm_add_q15",n),{.items = double(n),.bytes = 6.0*n},[&]
+        { arm_add_q15(buf.a15.data(),buf.b15.data(),buf.out15.data(),n); mcu_bench::clobberMemory(); });
+        bench.run(sized("arm_add_q7",n),{.items = double(n),.bytes = 3.0*n},[&]
+        { arm_add_q7(buf.a7.data(),buf.b7.data(),buf.out7.data(),n); mcu_bench::clobberMemory(); });
+        bench.run(sized("arm_mult_f32",n),{.items = double(n),.bytes = 12.0*n,.flops = double(n)},[&]
+        { arm_mult_f32(buf.a.data(),buf.b.data(),buf.out.data(),n); mcu_bench::clobberMemory(); });
+        bench.run(sized("arm_mult_q31",n),{.items = double(n),.bytes = 12.0*n,.macs = double(n)},[&]
+        { arm_mult_q31(buf.a31.data(),buf.b31.data(),buf.out31.data(),n); mcu_bench::clobberMemory(); });
+        bench.run(sized("arm_mult_q15",n),{.items = double(n),.bytes = 6.0*n,.macs = double(n)},[&]
+        { arm_mult_q15(buf.a15.data(),buf.b15.data(),buf.out15.data(),n); mcu_bench::clobberMemory(); });
+        bench.run(sized("arm_abs_f32",n),{.items = double(n),.bytes = 8.0*n},[&]
+        { arm_abs_f32(buf.a.data(),buf.out.data(),n); mcu_bench::clobberMemory(); });
+        bench.run(sized("arm_scale_q15",n),{.items = double(n),.bytes = 4.0*n,.macs = double(n)},[&]
+        { arm_scale_q15(buf.a15.data(),16384,1,buf.out15.data(),n); mcu_bench::clobberMemory(); });
+    }
+}
+
+//the dispatched functions
+void dotProdBench(mcu_bench::Runner& bench,Buffers& buf,const std::string& suffix)
+{
+    for( uint32_t n : sizes )
+    {
+        float32_t resultF;
+        q63_t result63;
+        q31_t result31;
+        bench.run(sized("arm_dot_prod_f32",n)+suffix,{.items = double(n),.bytes = 8.0*n,.flops = 2.0*n},[&]
+        { arm_dot_prod_f32(buf.a.data(),buf.b.data(),n,&resultF); mcu_bench::doNotOptimize(resultF); });
+        bench.run(sized("arm_dot_prod_q31",n)+suffix,{.items = double(n),.bytes = 8.0*n,.macs = double(n)},[&]
+        { arm_dot_prod_q31(buf.a31.data(),buf.b31.data(),n,&result63); mcu_bench::doNotOptimize(result63); });
+        bench.run(sized("arm_dot_prod_q15",n)+suffix,{.items = double(n),.bytes = 4.0*n,.macs = double(n)},[&]
+        { arm_dot_prod_q15(buf.a15.data(),buf.b15.data(),n,&result63); mcu_bench::doNotOptimize(result63); });
+        bench.run(sized("arm_dot_prod_q7",n)+suffix,{.items = double(n),.bytes = 2.0*n,.macs = double(n)},[&]
+        { arm_dot_prod_q7(buf.a7.data(),buf.b7.data(),n,&result31); mcu_bench::doNotOptimize(result31); });
+    }
+}
+
+//items are complex samples
+void complexBench(mcu_bench::Runner& bench,Buffers& buf)
+{
+    for( uint32_t n : {256u,1024u} )
+    {
+        bench.run(sized("arm_cmplx_mult_cmplx_f32",n),{.items = double(n),.bytes = 24.0*n,.flops = 6.0*n},[&]
+        { arm_cmplx_mult_cmplx_f32(buf.a.data(),buf.b.data(),buf.out.data(),n); mcu_bench::clobberMemory(); });
+        bench.run(sized("arm_cmplx_mag_f32",n),{.items = double(n),.bytes = 12.0*n},[&]
+        { arm_cmplx_mag_f32(buf.a.data(),buf.out.data(),n); mcu_bench::clobberMemory(); });
+        float32_t re, im;
+        bench.run(sized("arm_cmplx_dot_prod_f32",n),{.items = double(n),.bytes = 16.0*n,.flops = 8.0*n},[&]
+        { arm_cmplx_dot_prod_f32(buf.a.data(),buf.b.data(),n,&re,&im); mcu_bench::doNotOptimize(re); mcu_bench::doNotOptimize(im); });
+    }
+}
+
+//per sample functions, called on 1024 samples
+void controllerBench(mcu_bench::Runner& bench,Buffers& buf)
+{
+    constexpr uint32_t n = 1024;
+    arm_pid_instance_f32 pid{};
+    pid.Kp = 0.5f;
+    pid.Ki = 0.01f;
+    pid.Kd = 0.1f;
+    arm_pid_init_f32(&pid,1);
+    bench.run(sized("arm_pid_f32",n),{.items = n},[&]
+    {
+        for( uint32_t i=0 ; i<n ; i++ )
+            buf.out[i] = arm_pid_f32(&pid,buf.a[i]);
+        mcu_bench::clobberMemory();
+    });
+    bench.run(sized("arm_sin_cos_f32",n),{.items = n},[&]
+    {
+        for( uint32_t i=0 ; i<n ; i++ )
+            arm_sin_cos_f32(buf.a[i]*360.0f,&buf.out[i],&buf.out2[i]);
+        mcu_bench::clobberMemory();
+    });
+    bench.run(sized("arm_sin_f32",n),{.items = n},[&]
+    {
+        for( uint32_t i=0 ; i<n ; i++ )
+            buf.out[i] = arm_sin_f32(buf.a[i]*6.28f);
+        mcu_bench::clobberMemory();
+    });
+    bench.run(sized("arm_sqrt_f32",n),{.items = n},[&]
+    {
+        for( uint32_t i=0 ; i<n ; i++ )
+            arm_sqrt_f32(buf.a[i]+0.5f,&buf.out[i]);
+        mcu_bench::clobberMemory();
+    });
+    bench.run(sized("arm_sqrt_q15",n),{.items = n},[&]
+    {
+        for( uint32_t i=0 ; i<n ; i++ )
+            arm_sqrt_q15(q15_t(buf.a15[i] & 0x7FFF),&buf.out15[i]);
+        mcu_bench::clobberMemory();
+    });
+}
+
+void filteringBench(mcu_bench::Runner& bench,Buffers& buf)
+{
+    constexpr uint32_t block = 256;
+    for( uint16_t taps : {uint16_t(16),uint16_t(64)} )
+    {
+        std::vector<float32_t> coeffs(taps), state(taps+block-1);
+        for( uint16_t i=0 ; i<taps ; i++ )
+            coeffs[i] = 1.0f/float32_t(taps);
+        arm_fir_instance_f32 fir;
+        arm_fir_init_f32(&fir,taps,coeffs.data(),state.data(),block);
+        bench.run("arm_fir_f32/"+std::to_string(taps)+"_taps/"+std::to_string(block),
+                  {.items = block,.bytes = 8.0*block,.flops = 2.0*taps*block},[&]
+        { arm_fir_f32(&fir,buf.a.data(),buf.out.data(),block); mcu_bench::clobberMemory(); });
+
+        std::vector<q15_t> coeffs15(taps,q15_t(32767/taps)), state15(taps+block);
+        arm_fir_instance_q15 fir15;
+        arm_fir_init_q15(&fir15,taps,coeffs15.data(),state15.data(),block);
+        bench.run("arm_fir_q15/"+std::to_string(taps)+"_taps/"+std::to_string(block),
+                  {.items = block,.bytes = 4.0*block,.macs = double(taps)*block},[&]
+        { arm_fir_q15(&fir15,buf.a15.data(),buf.out15.data(),block); mcu_bench::clobberMemory(); });
+    }
+
+    //4 stages of a stable low pass section (b0 b1 b2 a1 a2, CMSIS sign of a)
+    constexpr uint8_t stages = 4;
+    std::vector<float32_t> sos;
+    for( int s=0 ; s<stages ; s++ )
+        sos.insert(sos.end(),{0.0675f,0.1349f,0.0675f,1.1430f,-0.4128f});
+    std::vector<float32_t> df1State(4*stages), df2TState(2*stages);
+    arm_biquad_casd_df1_inst_f32 df1;
+    arm_biquad_cascade_df1_init_f32(&df1,stages,sos.data(),df1State.data());
+    bench.run("arm_biquad_cascade_df1_f32/4_stages/"+std::to_string(block),
+              {.items = block,.bytes = 8.0*block,.flops = 9.0*stages*block},[&]
+    { arm_biquad_cascade_df1_f32(&df1,buf.a.data(),buf.out.data(),block); mcu_bench::clobberMemory(); });
+    arm_biquad_cascade_df2T_instance_f32 df2T;
+    arm_biquad_cascade_df2T_init_f32(&df2T,stages,sos.data(),df2TState.data());
+    bench.run("arm_biquad_cascade_df2T_f32/4_stages/"+std::to_string(block),
+              {.items = block,.bytes = 8.0*block,.flops = 9.0*stages*block},[&]
+    { arm_biquad_cascade_df2T_f32(&df2T,buf.a.data(),buf.out.data(),block); mcu_bench::clobberMemory(); });
+
+    bench.run("arm_conv_f32/256x64",{.items = 256+64-1,.flops = 2.0*256*64},[&]
+    { arm_conv_f32(buf.a.data(),256,buf.b.data(),64,buf.out.data()); mcu_bench::clobberMemory(); });
+}
+
+void matrixBench(mcu_bench::Runner& bench,Buffers& buf)
+{
+    for( uint16_t n : {uint16_t(8),uint16_t(16),uint16_t(32),uint16_t(64)} )
+    {
+        arm_matrix_instance_f32 a, b, out;
+        arm_mat_init_f32(&a,n,n,buf.a.data());
+        arm_mat_init_f32(&b,n,n,buf.b.data());
+        arm_mat_init_f32(&out,n,n,buf.out.data());
+        std::string size = std::to_string(n)+"x"+std::to_string(n);
+        bench.run("arm_mat_mult_f32/"+size,{.items = double(n)*n,.flops = 2.0*n*n*n},[&]
+        { arm_mat_mult_f32(&a,&b,&out); mcu_bench::clobberMemory(); });
+        bench.run("arm_mat_trans_f32/"+size,{.items = double(n)*n,.bytes = 8.0*n*n},[&]
+        { arm_mat_trans_f32(&a,&out); mcu_bench::clobberMemory(); });
+    }
+}
+
+void statisticsBench(mcu_bench::Runner& bench,Buffers& buf)
+{
+    for( uint32_t n : sizes )
+    {
+        float32_t result;
+        uint32_t index;
+        bench.run(sized("arm_mean_f32",n),{.items = double(n),.bytes = 4.0*n,.flops = double(n)},[&]
+        { arm_mean_f32(buf.a.data(),n,&result); mcu_bench::doNotOptimize(result); });
+        bench.run(sized("arm_max_f32",n),{.items = double(n),.bytes = 4.0*n},[&]
+        { arm_max_f32(buf.a.data(),n,&result,&index); mcu_bench::doNotOptimize(result); mcu_bench::doNotOptimize(index); });
+        bench.run(sized("arm_rms_f32",n),{.items = double(n),.bytes = 4.0*n,.flops = 2.0*n},[&]
+        { arm_rms_f32(buf.a.data(),n,&result); mcu_bench::doNotOptimize(result); });
+        bench.run(sized("arm_std_f32",n),{.items = double(n),.bytes = 4.0*n,.flops = 3.0*n},[&]
+        { arm_std_f32(buf.a.data(),n,&result); mcu_bench::doNotOptimize(result); });
+    }
+}
+
+void supportBench(mcu_bench::Runner& bench,Buffers& buf)
+{
+    for( uint32_t n : sizes )
+    {
+        bench.run(sized("arm_copy_f32",n),{.items = double(n),.bytes = 8.0*n},[&]
+        { arm_copy_f32(buf.a.data(),buf.out.data(),n); mcu_bench::clobberMemory(); });
+        bench.run(sized("arm_float_to_q15",n),{.items = double(n),.bytes = 6.0*n},[&]
+        { arm_float_to_q15(buf.a.data(),buf.out15.data(),n); mcu_bench::clobberMemory(); });
+        bench.run(sized("arm_q15_to_float",n),{.items = double(n),.bytes = 6.0*n},[&]
+        { arm_q15_to_float(buf.a15.data(),buf.out.data(),n); mcu_bench::clobberMemory(); });
+    }
+}
+
+//forward then inverse (scaled) in place, so that the data stays bounded:
+//items are the complex samples of both transforms, flops 5 N log2(N) each
+void transformBench(mcu_bench::Runner& bench,Buffers& buf)
+{
+    const std::pair<uint32_t,const arm_cfft_instance_f32*> cffts[] = {{256,&arm_cfft_sR_f32_len256},
+                                                                       {1024,&arm_cfft_sR_f32_len1024},
+                                                                       {4096,&arm_cfft_sR_f32_len4096}};
+    for( auto [n,cfft] : cffts )
+    {
+        std::copy(buf.a.begin(),buf.a.begin()+2*n,buf.out.begin());
+        bench.run(sized("arm_cfft_f32",n)+"/fwd_inv",{.items = 2.0*n,.flops = 2*5.0*n*std::log2(n)},[&]
+        {
+            arm_cfft_f32(cfft,buf.out.data(),0,1);
+            arm_cfft_f32(cfft,buf.out.data(),1,1);
+            mcu_bench::clobberMemory();
+        });
+    }
+    std::copy(buf.a15.begin(),buf.a15.begin()+2*1024,buf.out15.begin());
+    bench.run("arm_cfft_q15/1024/fwd_inv",{.items = 2.0*1024},[&]
+    {
+        arm_cfft_q15(&arm_cfft_sR_q15_len1024,buf.out15.data(),0,1);
+        arm_cfft_q15(&arm_cfft_sR_q15_len1024,buf.out15.data(),1,1);
+        mcu_bench::clobberMemory();
+    });
+    for( uint16_t n : {uint16_t(256),uint16_t(1024),uint16_t(4096)} )
+    {
+        arm_rfft_fast_instance_f32 rfft;
+        arm_rfft_fast_init_f32(&rfft,n);
+        std::vector<float32_t> spectrum(n);
+        std::copy(buf.a.begin(),buf.a.begin()+n,buf.out.begin());
+        bench.run(sized("arm_rfft_fast_f32",n)+"/fwd_inv",{.items = 2.0*n,.flops = 2*2.5*n*std::log2(n)},[&]
+        {
+            arm_rfft_fast_f32(&rfft,buf.out.data(),spectrum.data(),0);
+            arm_rfft_fast_f32(&rfft,spectrum.data(),buf.out.data(),1);
+            mcu_bench::clobberMemory();
+        });
+    }
+}
+
+}//namespace
+
+int main(int argc,char** argv)
+{
+    mcu_bench::Runner bench(argc,argv);
+#if defined(ARM_MATH_X86_AVX2) && defined(__GNUC__)
+    //the smoke test reports a skip, the bench target goes on with the others
+    if( !__builtin_cpu_supports("avx2") )
+    {
+        std::fprintf(stderr,"skipped: no AVX2\n");
+        return bench.quick() ? 77 : 0;
+    }
+#endif
+    bench.context("variant",MCU_DSP_VARIANT);
+    Buffers buf;
+    basicBench(bench,buf);
+#if defined(ARM_MATH_X86_DISPATCH)
+    for( int isa=ARM_X86_ISA_SSE2 ; isa<=int(arm_dispatch_x86_detect()) ; isa++ )
+    {
+        arm_dispatch_x86_select(arm_x86_isa(isa));
+        dotProdBench(bench,buf,std::string("/")+arm_dispatch_x86_name(arm_x86_isa(isa)));
+    }
+    arm_dispatch_x86_init();
+#else
+    dotProdBench(bench,buf,"");
+#endif
+    complexBench(bench,buf);
+    controllerBench(bench,buf);
+    filteringBench(bench,buf);
+    matrixBench(bench,buf);
+    statisticsBench(bench,buf);
+    supportBench(bench,buf);
+    transformBench(bench,buf);
+    return bench.finish();
+}
@@ -0,0 +1,140 @@
+//mcu::Serial: tx frames per second versus frame size on a 1 Mbaud loopback
+//uart (serial and pipelined inter-frame gap of 100us, pipelined with the gap
+//lowered to 20us by t_txMinGapUs), and SLIP/COBS framing with and without a
+//crc (encode + decode + crc of 256 byte frames through an in memory wire),
+//against mcu::SerialTranseiver (block writes) on the same wire.
+//End to end: one frame from a Serial to another over two 1 Mbaud loopback
+//uarts, per frame size and t_eofTimeoutUs (real_time is the latency).
+#include "Bench.hpp"
+#include "../Comm/Serial.hpp"
+#include "../Comm/StreamSocket.hpp"
+#include "../Comm/PC/SerialImp.hpp"
+#include "../Timer/PC/TimerImp.hpp"
+#include <deque>
+
+namespace
+{
+
+using Uart = mcu::LoopbackPort<0,1000000>;
+
+template<mcu::SerialTxMode t_mode,uint32_t t_minGapUs = 100>
+void txModeBench(mcu_bench::Runner& bench,const std::string& name)
+{
+    static mcu::Serial<4096,4096,Tim64_us,100,Uart::rxAvailable,Uart::rxRead,Uart::txReady,Uart::txWrite,t_mode,t_minGapUs> serial;
+    serial.txInit();
+    constexpr int frames = 8;
+    std::vector<uint8_t> frame(256,0x5A);
+    for( size_t size : {8,32,128,256} )
+    {
+        bench.run("serial_tx/"+name+"/"+std::to_string(size),{.items = frames,.bytes = double(frames*size)},[&]
+        {
+            for( int i=0 ; i<frames ; i++ )
+                serial.txFrameAppend(frame.data(),uint16_t(size));
+            while( serial.txFramesPending() )
+                serial.txTask();
+            //nobody reads the wire
+            while( Uart::rxAvailable() )
+                Uart::rxRead();
+        });
+    }
+}
+
+std::deque<uint8_t> wire;
+uint16_t wireRxAvailable() { return wire.size() > 0; }
+uint8_t wireRxRead() { auto data = wire.front(); wire.pop_front(); return data; }
+bool alwaysTxReady() { return true; }
+void wireTxWrite(uint8_t data) { wire.push_back(data); }
+
+template<typename t_Framing,typename t_Crc>
+void framingBench(mcu_bench::Runner& bench,const std::string& name)
+{
+    static mcu::Serial<600,600,Tim64_us,0,wireRxAvailable,wireRxRead,alwaysTxReady,wireTxWrite,
+                       mcu::SerialTxMode::serial,0,t_Framing,t_Crc> serial;
+    serial.txInit();
+    serial.rxInit();
+    std::vector<uint8_t> frame(256);
+    for( size_t i=0 ; i<frame.size() ; i++ )
+        frame[i] = uint8_t(i*37);
+    bench.run("serial/"+name+"/256",{.items = 1,.bytes = double(frame.size())},[&]
+    {
+        serial.txFrameAppend(frame.data(),frame.size());
+        while( serial.rxFramesAvailable() == 0 )
+        {
+            serial.txTask();
+            serial.rxTask();
+        }
+        serial.rxFrameDiscard();
+    });
+}
+
+uint32_t wireRxCount() { return uint32_t(wire.size()); }
+void wireTxWriteBlock(const uint8_t* buff,uint32_t len) { wire.insert(wire.end(),buff,buff+len); }
+
+template<typename t_Framing>
+void transceiverBench(mcu_bench::Runner& bench,const std::string& name)
+{
+    static mcu::SerialTranseiver<600,600,Tim64_us,0,wireRxCount,wireRxRead,alwaysTxReady,wireTxWriteBlock,t_Framing> serial;
+    std::vector<uint8_t> frame(256);
+    for( size_t i=0 ; i<frame.size() ; i++ )
+        frame[i] = uint8_t(i*37);
+    bench.run("transceiver/"+name+"/256",{.items = 1,.bytes = double(frame.size())},[&]
+    {
+        serial.tx_send_then_eof(frame.data(),uint32_t(frame.size()));
+        while( !serial.rx_frame_available() )
+        {
+            serial.tx_task();
+            serial.rx_task();
+        }
+        serial.rx_frame_discard();
+    });
+}
+
+using A = mcu::LoopbackPort<2,1000000,3>;
+using B = mcu::LoopbackPort<3,1000000,2>;
+
+template<uint32_t t_eofUs>
+void endToEndBench(mcu_bench::Runner& bench)
+{
+    static mcu::Serial<1024,1024,Tim64_us,t_eofUs,A::rxAvailable,A::rxRead,A::txReady,A::txWrite> a;
+    static mcu::Serial<1024,1024,Tim64_us,t_eofUs,B::rxAvailable,B::rxRead,B::txReady,B::txWrite> b;
+    a.txInit();
+    b.rxInit();
+    std::vector<uint8_t> frame(256,0x5A);
+    const auto sendFrame = [&](size_t size)
+    {
+        a.txFrameAppend(frame.data(),uint16_t(size));
+        while( b.rxFramesAvailable() == 0 )
+        {
+            a.txTask();
+            b.rxTask();
+        }
+        b.rxFrameDiscard();
+    };
+    //the first frame also waits for the startup eof of both sides
+    sendFrame(1);
+    for( size_t size : {16,64,256} )
+    {
+        bench.run("serial_loopback/eof_"+std::to_string(t_eofUs)+"us/"+std::to_string(size),{.items = 1,.bytes = double(size)},[&]
+        { sendFrame(size); });
+    }
+}
+
+}//namespace
+
+int main(int argc,char** argv)
+{
+    mcu_bench::Runner bench(argc,argv);
+    txModeBench<mcu::SerialTxMode::serial>(bench,"serial");
+    txModeBench<mcu::SerialTxMode::pipelined>(bench,"pipelined");
+    txModeBench<mcu::SerialTxMode::pipelined,20>(bench,"pipelined_gap20");
+    framingBench<mcu::SlipFraming,mcu::NoCrc>(bench,"slip");
+    framingBench<mcu::SlipFraming,mcu::Crc8>(bench,"slip_crc8");
+    framingBench<mcu::CobsFraming,mcu::NoCrc>(bench,"cobs");
+    framingBench<mcu::CobsFraming,mcu::Crc16Ccitt>(bench,"cobs_crc16");
+    framingBench<mcu::CobsFraming,mcu::Crc32>(bench,"cobs_crc32");
+    transceiverBench<mcu::SlipFraming>(bench,"slip");
+    transceiverBench<mcu::CobsFraming>(bench,"cobs");
+    endToEndBench<100>(bench);
+    endToEndBench<1000>(bench);
+    return bench.finish();
+}
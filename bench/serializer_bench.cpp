@@ -0,0 +1,142 @@
+//encoding records: byte copy through SerializableT (host layout), mcu::Layout
+//(fixed little/big endian layout) and mcu::Schema (delta + varint)
+#include "Bench.hpp"
+#include "../Utils/Serializer.hpp"
+#include "../Utils/SerializableT.hpp"
+#include "../Utils/Schema.hpp"
+#include <cmath>
+
+namespace
+{
+
+struct Tele
+{
+    uint32_t time;
+    int16_t  temp;
+    float    v[3];
+    uint8_t  flags;
+};
+using TeleLayout = mcu::Layout<&Tele::time,&Tele::temp,&Tele::v,&Tele::flags>;
+
+struct Sample
+{
+    uint32_t time;
+    int16_t  temp;
+    uint16_t adc;
+    float    v;
+    bool     alarm;
+    bool     door;
+    uint8_t  state;
+    int32_t  pos;
+};
+using SampleSchema = mcu::Schema<mcu::VarintField<&Sample::time,true>,mcu::ZigzagField<&Sample::temp>,mcu::VarintField<&Sample::adc>,
+                                 mcu::RawField<&Sample::v>,mcu::BitField<&Sample::alarm>,mcu::BitField<&Sample::door>,
+                                 mcu::VarintField<&Sample::state>,mcu::ZigzagField<&Sample::pos,true>>;
+
+constexpr size_t records = 1000;
+
+}//namespace
+
+int main(int argc,char** argv)
+{
+    mcu_bench::Runner bench(argc,argv);
+    std::vector<Tele> teles(records);
+    for( size_t i=0 ; i<records ; i++ )
+        teles[i] = {uint32_t(i),int16_t(i),{float(i),1,2},uint8_t(i)};
+    std::vector<uint8_t> out(records*sizeof(Tele));
+    bench.run("tele/SerializableT",{.items = records,.bytes = double(records*sizeof(Tele))},[&]
+    {
+        size_t k = 0;
+        for( auto& tele : teles )
+        {
+            SerializableT<Tele> s;
+            s.value = tele;
+            for( size_t i=0 ; i<sizeof(Tele) ; i++ )
+                out[k++] = s.raw[i];
+        }
+        mcu_bench::clobberMemory();
+    });
+    bench.run("tele/Layout/little",{.items = records,.bytes = double(records*TeleLayout::size)},[&]
+    {
+        uint8_t* p = out.data();
+        for( auto& tele : teles )
+            p = TeleLayout::encode(tele,p);
+        mcu_bench::clobberMemory();
+    });
+    bench.run("tele/Layout/big",{.items = records,.bytes = double(records*TeleLayout::size)},[&]
+    {
+        uint8_t* p = out.data();
+        for( auto& tele : teles )
+            p = TeleLayout::encode<std::endian::big>(tele,p);
+        mcu_bench::clobberMemory();
+    });
+
+    std::vector<uint16_t> values(4096);
+    std::vector<uint8_t> valuesOut(2*values.size());
+    bench.run("u16_array/SerializableT",{.items = double(values.size()),.bytes = double(valuesOut.size())},[&]
+    {
+        for( size_t i=0 ; i<values.size() ; i++ )
+        {
+            SerializableT<uint16_t> s(values[i]);
+            valuesOut[2*i] = s.raw[0];
+            valuesOut[2*i+1] = s.raw[1];
+        }
+        mcu_bench::clobberMemory();
+    });
+    bench.run("u16_array/store",{.items = double(values.size()),.bytes = double(valuesOut.size())},[&]
+    {
+        uint8_t* p = valuesOut.data();
+        for( auto value : values )
+            p = mcu::store(p,value);
+        mcu_bench::clobberMemory();
+    });
+
+    std::vector<Sample> samples;
+    uint32_t time = 1000000;
+    int32_t pos = -5000;
+    for( size_t i=0 ; i<10000 ; i++ )
+    {
+        time += 1000+(i%7);
+        pos += int32_t(i%5)-2;
+        samples.push_back({time,int16_t(-300+int(i%50)),uint16_t(2000+(i*37)%400),float(std::sin(i*0.01)),
+                           i%100 == 0,(i/500)%2 == 1,uint8_t(i%4),pos});
+    }
+    SampleSchema::Encoder encoder;
+    SampleSchema::Decoder decoder;
+    std::vector<uint8_t> buff(SampleSchema::maxSize*samples.size());
+    std::vector<size_t> lengths(samples.size());
+    bench.run("sample/Schema/encode",{.items = double(samples.size())},[&]
+    {
+        uint8_t* p = buff.data();
+        for( size_t i=0 ; i<samples.size() ; i++ )
+        {
+            lengths[i] = encoder.encode(samples[i],p,i == 0);
+            p += lengths[i];
+        }
+        mcu_bench::clobberMemory();
+    });
+    bench.run("sample/Schema/decode",{.items = double(samples.size())},[&]
+    {
+        const uint8_t* p = buff.data();
+        Sample sample;
+        for( size_t i=0 ; i<samples.size() ; i++ )
+        {
+            decoder.decode(p,lengths[i],sample);
+            p += lengths[i];
+        }
+        mcu_bench::doNotOptimize(sample.pos);
+    });
+    bench.run("sample/SerializableT",{.items = double(samples.size())},[&]
+    {
+        uint8_t* p = buff.data();
+        for( auto& sample : samples )
+        {
+            SerializableT<Sample> s;
+            s.value = sample;
+            for( size_t i=0 ; i<sizeof(Sample) ; i++ )
+                *p++ = s.raw[i];
+        }
+        mcu_bench::clobberMemory();
+    });
+    return bench.finish();
+}
@@ -0,0 +1,68 @@
+//mcu::StreamSocket throughput over two loopback uarts fast enough (100 Mbaud)
+//for the protocol to be the limit, on a clean link and on lossy links (each
+//byte lost with the given probability, retransmission timeout 5ms)
+#include "Bench.hpp"
+#include "../Comm/StreamSocket.hpp"
+#include "../Comm/PC/SerialImp.hpp"
+#include "../Timer/PC/TimerImp.hpp"
+
+namespace
+{
+
+using L0 = mcu::LoopbackPort<0,100000000,1>;
+using L1 = mcu::LoopbackPort<1,100000000,0>;
+using S0 = mcu::Serial<1024,1024,Tim64_us,100,L0::rxAvailable,L0::rxRead,L0::txReady,L0::txWrite,mcu::SerialTxMode::serial,100,mcu::CobsFraming,mcu::Crc16Ccitt>;
+using S1 = mcu::Serial<1024,1024,Tim64_us,100,L1::rxAvailable,L1::rxRead,L1::txReady,L1::txWrite,mcu::SerialTxMode::serial,100,mcu::CobsFraming,mcu::Crc16Ccitt>;
+using K0 = mcu::StreamSocket<S0,Tim64_us,5000,512,512,8,64>;
+using K1 = mcu::StreamSocket<S1,Tim64_us,5000,512,512,8,64>;
+
+void streamBench(mcu_bench::Runner& bench,uint32_t lossPpm)
+{
+    L0::clear();
+    L1::clear();
+    L0::setLossPpm(lossPpm);
+    L1::setLossPpm(lossPpm);
+    S0 s0;
+    S1 s1;
+    K0 k0(s0);
+    K1 k1(s1);
+    s0.rxInit();
+    s0.txInit();
+    s1.rxInit();
+    s1.txInit();
+    constexpr size_t total = 4096;
+    uint8_t data[64] = {};
+    uint8_t buff[256];
+    bench.run("stream_socket/loss_"+std::to_string(lossPpm)+"ppm/4096",{.items = total,.bytes = total},[&]
+    {
+        size_t written = 0, received = 0;
+        while( received < total )
+        {
+            while( written < total )
+            {
+                auto len = k0.write(data,K0::TxIdxType(std::min(sizeof(data),total-written)));
+                if( len == 0 )
+                    break;
+                written += len;
+            }
+            s0.rxTask();
+            s1.rxTask();
+            k0.task();
+            k1.task();
+            s0.txTask();
+            s1.txTask();
+            received += k1.read(buff,sizeof(buff));
+        }
+    });
+}
+
+}//namespace
+
+int main(int argc,char** argv)
+{
+    mcu_bench::Runner bench(argc,argv);
+    streamBench(bench,0);
+    streamBench(bench,100);
+    streamBench(bench,1000);
+    return bench.finish();
+}
@@ -0,0 +1,74 @@
+//task() called every simulated 1ms on a 1us tick: mcu::TimerWheel with 10k
+//periodic timers against polling one mcu::Timer per job, and the wheel with a
+//single far timer (the empty slots are skipped)
+#include "Bench.hpp"
+#include "../Timer/TimerWheel.hpp"
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+uint32_t fakeTime = 0;
+auto fakeTime_us() -> uint32_t { return fakeTime; }
+
+using Wheel = mcu::TimerWheel<uint32_t,1,1000000,fakeTime_us>;
+using Poll  = mcu::Timer<uint32_t,1,1000000,fakeTime_us>;
+
+constexpr size_t   timers = 10000;
+constexpr uint32_t step_us = 1000;
+
+uint64_t callbacks = 0;
+
+}//namespace
+
+int main(int argc,char** argv)
+{
+    mcu_bench::Runner bench(argc,argv);
+    std::mt19937 rng(2);
+    {
+        Wheel wheel;
+        std::vector<std::unique_ptr<Wheel::Entry>> entries;
+        for( size_t i=0 ; i<timers ; i++ )
+        {
+            entries.emplace_back(new Wheel::Entry([](void*){ callbacks++; }));
+            wheel.start(*entries.back(),uint64_t(1+rng()%1000000),uint64_t(1000+rng()%1000000));
+        }
+        bench.run("timer_wheel/10000_timers/1ms_step",{.items = 1},[&]
+        {
+            fakeTime += step_us;
+            wheel.task();
+        });
+    }
+    {
+        std::vector<Poll> polled(timers);
+        std::vector<uint32_t> period(timers);
+        for( auto& p : period )
+            p = 1000+rng()%1000000;
+        bench.run("timer_polling/10000_timers/1ms_step",{.items = 1},[&]
+        {
+            fakeTime += step_us;
+            for( size_t k=0 ; k<timers ; k++ )
+            {
+                if( polled[k] >= period[k] )
+                {
+                    polled[k] -= period[k];
+                    callbacks++;
+                }
+            }
+        });
+    }
+    {
+        Wheel wheel;
+        Wheel::Entry entry([](void*){ callbacks++; });
+        wheel.start(entry,uint64_t(10000000),uint64_t(10000000));
+        bench.run("timer_wheel/1_timer_10s/1ms_step",{.items = 1},[&]
+        {
+            fakeTime += step_us;
+            wheel.task();
+        });
+    }
+    mcu_bench::doNotOptimize(callbacks);
+    return bench.finish();
+}
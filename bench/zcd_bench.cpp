@@ -0,0 +1,75 @@
+//zero crossing detectors on a 50Hz sine sampled at 200kHz: zcd_t per sample
+//and per block, with the cubic fit + statistics + pll, zcd_rt_t and 12
+//interleaved channels with zcd_multi_t
+#include "Bench.hpp"
+#include "../DSP/zcd_multi.h"
+#include <cmath>
+
+namespace
+{
+
+constexpr size_t block = 4096;
+constexpr size_t channels = 12;
+
+}//namespace
+
+int main(int argc,char** argv)
+{
+    mcu_bench::Runner bench(argc,argv);
+    //a whole number of periods per block would repeat the same crossings
+    std::vector<float> x(block);
+    for( size_t i=0 ; i<x.size() ; i++ )
+        x[i] = float(std::sin(2*M_PI*49.7*i/200000.0+0.3)+0.001*std::sin(i*1.7));
+    const mcu_bench::Work work{.items = block,.bytes = block*sizeof(float)};
+
+    zcd_t<200000.0f,0.01f> perSample;
+    bench.run("zcd_t/process_sample",work,[&]
+    {
+        for( auto s : x )
+            perSample.process_sample(s);
+        mcu_bench::doNotOptimize(perSample.get_half_period());
+    });
+    zcd_t<200000.0f,0.01f> perBlock;
+    bench.run("zcd_t/process_block",work,[&]
+    {
+        perBlock.process_block(x.data(),x.size());
+        mcu_bench::doNotOptimize(perBlock.get_half_period());
+    });
+    zcd_t<200000.0f,0.01f,zcd_fit::cubic,32> cubic;
+    cubic.enable_pll(0.2f,0.01f);
+    bench.run("zcd_t/cubic_stats_pll/process_block",work,[&]
+    {
+        cubic.process_block(x.data(),x.size());
+        mcu_bench::doNotOptimize(cubic.frequency());
+    });
+    zcd_rt_t<> runtime(200000.0f,0.01f);
+    bench.run("zcd_rt_t/process_block",work,[&]
+    {
+        runtime.process_block(x.data(),x.size());
+        mcu_bench::doNotOptimize(runtime.get_half_period());
+    });
+
+    std::vector<float> interleaved(block*channels);
+    for( size_t f=0 ; f<block ; f++ )
+        for( size_t c=0 ; c<channels ; c++ )
+            interleaved[f*channels+c] = float(std::sin(2*M_PI*(49.9+0.02*c)*f/200000.0+c*2.1));
+    const mcu_bench::Work multiWork{.items = block*channels,.bytes = block*channels*sizeof(float)};
+    std::vector<zcd_t<200000.0f,0.01f>> single(channels);
+    std::vector<float> channel(block);
+    bench.run("zcd_t/12ch/deinterleave_process_block",multiWork,[&]
+    {
+        for( size_t c=0 ; c<channels ; c++ )
+        {
+            for( size_t f=0 ; f<block ; f++ )
+                channel[f] = interleaved[f*channels+c];
+            single[c].process_block(channel.data(),block);
+        }
+        mcu_bench::doNotOptimize(single[0].get_half_period());
+    });
+    zcd_multi_t<200000.0f,0.01f,channels> multi;
+    bench.run("zcd_multi_t/12ch/process_frames",multiWork,[&]
+    {
+        mcu_bench::doNotOptimize(multi.process_frames(interleaved.data(),block).crossings[0]);
+    });
+    return bench.finish();
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdio>
+
+//Minimal checks for the host tests: a failed check prints the expression and
+//the test keeps running, main() returns mcu_test::result() (non zero fails
+//the ctest run). Independent of NDEBUG, unlike assert().
+namespace mcu_test
+{
+
+inline int failures = 0;
+
+inline bool check(bool ok,const char* expr,const char* file,int line)
+{
+    if( !ok )
+    {
+        failures++;
+        std::printf("%s:%d: check failed: %s\n",file,line,expr);
+    }
+    return ok;
+}
+
+inline int result()
+{
+    if( failures != 0 )
+    {
+        std::printf("%d check(s) failed\n",failures);
+        return 1;
+    }
+    std::printf("ok\n");
+    return 0;
+}
+
+}//namespace mcu_test
+
+#define MCU_CHECK(expr) ::mcu_test::check(bool(expr),#expr,__FILE__,__LINE__)
@@ -0,0 +1,223 @@
+//mcu::CmdParser: pipelining order and concurrency, binary mode, coroutine
+//handlers and the profiler dump handler
+#include "Check.hpp"
+#include "../Comm/CmdCoroutine.h"
+#include "../Comm/CmdParser.h"
+#include "../Comm/ProfilerCmd.h"
+#include "../Timer/PC/TimerImp.hpp"
+#include <string>
+#include <vector>
+
+using namespace mcu;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+using Args = VLItemLifo<64>;
+using Handler = CmdParserRetType(*)(Args&);
+
+//pipelining: "slow" needs 50 calls, "fast" finishes at once
+std::string trace;
+
+CmdParserRetType fast(Args& args)
+{
+    trace.append("F").append(args.peekStringAt(1).value_or("")).append(";");
+    return CmdParserRetType::finished_ok;
+}
+
+CmdParserRetType slow(Args& args)
+{
+    static int calls = 0;
+    if( ++calls < 50 )
+        return CmdParserRetType::not_finished;
+    calls = 0;
+    trace.append("S").append(args.peekStringAt(1).value_or("")).append(";");
+    return CmdParserRetType::finished_ok;
+}
+
+constexpr std::array<std::pair<std::string_view,Handler>,2> pipelineCommands{{{"fast",fast},{"slow",slow}}};
+
+template<typename t_Parser>
+std::string runPipeline()
+{
+    t_Parser parser;
+    parser.start();
+    trace.clear();
+    for( char ch : std::string("slow 1\rfast 2\rslow 3\rfast 4\r") )
+        parser.pushData(uint8_t(ch));
+    for( int i=0 ; i<400 ; i++ )
+        parser();
+    return trace;
+}
+
+void checkPipelining()
+{
+    //(1,1): one after the other, in arrival order
+    MCU_CHECK((runPipeline<CmdParser<' ','\r',64,2,pipelineCommands>>() == "S1;F2;S3;F4;"));
+    MCU_CHECK((runPipeline<CmdParser<' ','\r',64,2,pipelineCommands,4,1>>() == "S1;F2;S3;F4;"));
+    MCU_CHECK((runPipeline<CmdParser<' ','\r',64,2,pipelineCommands,4,4>>() == "F2;F4;S1;S3;"));
+    //the second "slow" waits for the first one without taking one of the
+    //two places, so "fast 4" is not starved
+    MCU_CHECK((runPipeline<CmdParser<' ','\r',64,2,pipelineCommands,4,2>>() == "F2;F4;S1;S3;"));
+}
+
+//binary mode: varint length, varint command id, varint length prefixed args
+std::string echoed;
+
+CmdParserRetType echo(Args& args)
+{
+    for( int i=0 ; i<args.itemsCount() ; i++ )
+        echoed += std::string(args.peekStringAt(i).value_or("?")) + "|";
+    echoed += ";";
+    return CmdParserRetType::finished_ok;
+}
+
+CmdParserRetType nop(Args&) { return CmdParserRetType::finished_ok; }
+
+constexpr std::array<std::pair<std::string_view,Handler>,2> binaryCommands{{{"nop",nop},{"echo",echo}}};
+
+void appendVarint(std::vector<uint8_t>& out,uint32_t value)
+{
+    while( value >= 0x80 )
+    {
+        out.push_back(uint8_t(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(uint8_t(value));
+}
+
+std::vector<uint8_t> binaryFrame(uint32_t id,const std::vector<std::string>& args)
+{
+    std::vector<uint8_t> body;
+    appendVarint(body,id);
+    for( auto& arg : args )
+    {
+        appendVarint(body,uint32_t(arg.size()));
+        body.insert(body.end(),arg.begin(),arg.end());
+    }
+    std::vector<uint8_t> frame;
+    appendVarint(frame,uint32_t(body.size()));
+    frame.insert(frame.end(),body.begin(),body.end());
+    return frame;
+}
+
+void checkBinary()
+{
+    using Parser = CmdParser<' ','\r',64,2,binaryCommands,1,1,CmdParserMode::binary>;
+    static_assert(Parser::commandId("echo") == 1);
+    Parser parser;
+    parser.start();
+    //unknown id 5 and a frame longer than t_frameMaxLen are skipped
+    std::vector<uint8_t> stream;
+    for( auto frame : {binaryFrame(1,{"ab"}),binaryFrame(5,{"x"}),binaryFrame(1,{std::string(100,'z')}),
+                       binaryFrame(1,{"c\r d",""}),binaryFrame(0,{})} )
+        stream.insert(stream.end(),frame.begin(),frame.end());
+    size_t idx = 0;
+    for( int i=0 ; i<2000 ; i++ )
+    {
+        while( idx < stream.size() && parser.rxFreeSpace() )
+            parser.pushData(stream[idx++]);
+        parser();
+    }
+    MCU_CHECK(echoed == "echo|ab|;echo|c\r d||;");
+}
+
+//coroutine handlers: waiting ones do not block the others
+std::string coTrace;
+int coFlag = 0;
+
+CmdTask waiter(Args& args)
+{
+    std::string arg(args.peekStringAt(1).value_or(""));
+    co_await until([]{ return coFlag > 0; });
+    coTrace += "W" + arg + ";";
+    co_await delay<Tim64_us>(2ms);
+    coTrace += "D" + arg + ";";
+    co_return CmdParserRetType::finished_ok;
+}
+
+CmdTask quick(Args&)
+{
+    coTrace += "Q;";
+    co_return CmdParserRetType::finished_ok;
+}
+
+constexpr std::array<std::pair<std::string_view,Handler>,2> coroutineCommands{{{"wait",cmdCoroutine<64,waiter>},{"q",cmdCoroutine<64,quick>}}};
+
+void checkCoroutines()
+{
+    CmdParser<' ','\r',64,2,coroutineCommands,4,4> parser;
+    parser.start();
+    for( char ch : std::string("wait 1\rq\rq\r") )
+        parser.pushData(uint8_t(ch));
+    for( int i=0 ; i<100 ; i++ )
+        parser();
+    MCU_CHECK(coTrace == "Q;Q;");
+    coFlag = 1;
+    auto t0 = std::chrono::steady_clock::now();
+    while( parser.pendingCommands() != 0 && std::chrono::steady_clock::now()-t0 < 1s )
+        parser();
+    MCU_CHECK(coTrace == "Q;Q;W1;D1;");
+    MCU_CHECK(parser.pendingCommands() == 0);
+}
+
+//profiler dump on a fake clock: every scope lasts exactly one tick
+uint32_t fakeTicks = 0;
+auto fakeTick_us() -> uint32_t { return fakeTicks++; }
+using FakeTimer = mcu::Timer<uint32_t,1,1000000,fakeTick_us>;
+
+std::string dumped;
+int writeBudget = 0;
+bool dumpWrite(std::string_view line)
+{
+    if( writeBudget-- <= 0 )
+        return false;
+    dumped.append(line);
+    return true;
+}
+
+constexpr std::array<std::pair<std::string_view,Handler>,1> profilerCommands{{{"dump",profilerDump<FakeTimer,64,dumpWrite>}}};
+
+void checkProfilerDump()
+{
+    static ProfileProbe<FakeTimer> work("work");
+    static ProfileProbe<FakeTimer> idle("idle");
+    for( int i=0 ; i<3 ; i++ )
+        ProfileProbe<FakeTimer>::Scope scope(work);
+    CmdParser<' ','\r',64,1,profilerCommands> parser;
+    parser.start();
+    //one line per call: the handler retries the lines that did not fit
+    for( char ch : std::string("dump reset\r") )
+        parser.pushData(uint8_t(ch));
+    for( int i=0 ; i<100 ; i++ )
+    {
+        writeBudget = 1;
+        parser();
+    }
+    MCU_CHECK(dumped == "# ticks 1/1000000\n"
+                        "work 3 1 1 1 0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0\n"
+                        "idle 0 0 0 0 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0\n");
+    dumped.clear();
+    for( char ch : std::string("dump\r") )
+        parser.pushData(uint8_t(ch));
+    for( int i=0 ; i<100 ; i++ )
+    {
+        writeBudget = 5;
+        parser();
+    }
+    MCU_CHECK(dumped == "# ticks 1/1000000\n"
+                        "work 0 0 0 0 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0\n"
+                        "idle 0 0 0 0 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0\n");
+}
+
+}//namespace
+
+int main()
+{
+    checkPipelining();
+    checkBinary();
+    checkCoroutines();
+    checkProfilerDump();
+    return mcu_test::result();
+}
@@ -0,0 +1,86 @@
+//mcu::FifoBuffer / FifoRaw under both storage policies, VLItemFifo and
+//VLItemLifo
+#include "Check.hpp"
+#include "../Container/FifoBuffer.hpp"
+#include "../Container/VLItemFifo.h"
+#include "../Container/VLItemLifo.h"
+
+using mcu::StoragePolicy;
+
+namespace
+{
+
+//size is the default: the existing layouts do not change
+static_assert(sizeof(mcu::FifoBuffer<uint8_t,200>) == 202);
+static_assert(sizeof(mcu::FifoBuffer<uint8_t,200,false,StoragePolicy::speed>) == 256);
+
+template<typename t_Fifo>
+void checkFifo()
+{
+    t_Fifo fifo;
+    MCU_CHECK(fifo.isEmpty());
+    //several laps, so that the indexes wrap
+    uint8_t next = 0, expected = 0;
+    bool inOrder = true;
+    for( int lap=0 ; lap<50 ; lap++ )
+    {
+        while( !fifo.isFull() )
+            fifo.put(next++);
+        MCU_CHECK(fifo.length() == 15);
+        MCU_CHECK(fifo.freeSpace() == 0);
+        for( int i=0 ; i<10 ; i++ )
+            inOrder &= fifo.get() == expected++;
+        MCU_CHECK(fifo.length() == 5);
+    }
+    MCU_CHECK(inOrder);
+    fifo.remove(2);
+    MCU_CHECK(fifo.peek() == uint8_t(expected+2));
+    fifo.remove(1,true);
+    MCU_CHECK(fifo.length() == 2);
+    fifo.clear();
+    MCU_CHECK(fifo.isEmpty());
+}
+
+template<typename t_Fifo>
+void checkOverride()
+{
+    t_Fifo fifo;
+    for( uint8_t i=0 ; i<40 ; i++ )
+        fifo.put(i);
+    //keeps the newest 15
+    MCU_CHECK(fifo.length() == 15);
+    MCU_CHECK(fifo.peek() == 25);
+}
+
+void checkVLItems()
+{
+    mcu::VLItemFifo<uint8_t,64> fifo;
+    for( int i=0 ; i<20 ; i++ )
+    {
+        fifo.push(uint32_t(0xA0B0C0D0+i));
+        fifo.commitItem();
+        if( fifo.itemsCount() > 3 )
+            fifo.pop();
+    }
+    MCU_CHECK(fifo.itemsCount() == 3);
+    MCU_CHECK(fifo.firstItemLength() == 4);
+    mcu::VLItemLifo<64> lifo;
+    lifo.pushItem(uint32_t(0xDEADBEEF));
+    lifo.pushItem(uint16_t(7));
+    MCU_CHECK(lifo.popItem<uint16_t>().value() == 7);
+    MCU_CHECK(lifo.popItem<uint32_t>().value() == 0xDEADBEEF);
+}
+
+}//namespace
+
+int main()
+{
+    checkFifo<mcu::FifoBuffer<uint8_t,16>>();
+    checkFifo<mcu::FifoBuffer<uint8_t,16,false,StoragePolicy::speed>>();
+    checkFifo<mcu::FifoRaw<uint8_t,16>>();
+    checkFifo<mcu::FifoRaw<uint8_t,16,false,StoragePolicy::speed>>();
+    checkOverride<mcu::FifoBuffer<uint8_t,16,true>>();
+    checkOverride<mcu::FifoRaw<uint8_t,16,true,StoragePolicy::speed>>();
+    checkVLItems();
+    return mcu_test::result();
+}
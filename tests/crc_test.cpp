@@ -0,0 +1,57 @@
+//mcu::Crc: check values of every table strategy, strategies against each
+//other on random data, append + check() and corruption detection
+#include "Check.hpp"
+#include "../Utils/Crc.hpp"
+#include <random>
+#include <vector>
+
+using namespace mcu;
+
+namespace
+{
+
+constexpr uint8_t checkInput[] = "123456789";
+
+static_assert(Crc32::compute(checkInput,9) == 0xCBF43926);
+
+template<template<CrcTable> class t_Crc,typename t_Value>
+void checkCrc(t_Value expected)
+{
+    MCU_CHECK(t_Crc<CrcTable::bitwise>::compute(checkInput,9) == expected);
+    MCU_CHECK(t_Crc<CrcTable::nibble>::compute(checkInput,9) == expected);
+    MCU_CHECK(t_Crc<CrcTable::byte>::compute(checkInput,9) == expected);
+    MCU_CHECK(t_Crc<CrcTable::slice8>::compute(checkInput,9) == expected);
+    std::mt19937 rng(2);
+    for( int it=0 ; it<200 ; it++ )
+    {
+        std::vector<uint8_t> data(rng()%100);
+        for( auto& b : data )
+            b = uint8_t(rng());
+        auto ref = t_Crc<CrcTable::bitwise>::compute(data.data(),data.size());
+        MCU_CHECK(t_Crc<CrcTable::slice8>::compute(data.data(),data.size()) == ref);
+        MCU_CHECK(t_Crc<CrcTable::nibble>::compute(data.data(),data.size()) == ref);
+        //appended crc: check() must accept the frame, and reject it once corrupted
+        t_Crc<CrcTable::slice8> crc;
+        crc.update(data.data(),data.size());
+        for( size_t i=0 ; i<crc.size ; i++ )
+            data.push_back(crc.byteAt(i));
+        t_Crc<CrcTable::slice8> good;
+        good.update(data.data(),data.size());
+        MCU_CHECK(good.check());
+        data[0] ^= 1;
+        t_Crc<CrcTable::nibble> bad;
+        bad.update(data.data(),data.size());
+        MCU_CHECK(!bad.check());
+    }
+}
+
+}//namespace
+
+int main()
+{
+    checkCrc<Crc8_t>(uint8_t(0xF4));
+    checkCrc<Crc16Ccitt_t>(uint16_t(0x29B1));
+    checkCrc<Crc16Modbus_t>(uint16_t(0x4B37));
+    checkCrc<Crc32_t>(0xCBF43926u);
+    return mcu_test::result();
+}
@@ -0,0 +1,242 @@
+/*
+ * BasicMath functions of a cmsisdsp_<variant> library (add, mult, abs, scale,
+ * dot_prod, all types) against the plain C reference build (dsp_ref_names.h):
+ * bit-exact for every length 0..70 and misalignment, on random data, on the
+ * saturation extremes and on the most negative values. arm_dot_prod_f32 sums
+ * in another order in the vector versions and is compared with a relative
+ * tolerance.
+ */
+
+#include "arm_math.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(ARM_MATH_X86_DISPATCH)
+#include "arm_dispatch_x86.h"
+#endif
+
+void ref_arm_add_f32(const float32_t * pSrcA, const float32_t * pSrcB, float32_t * pDst, uint32_t blockSize);
+void ref_arm_add_q31(const q31_t * pSrcA, const q31_t * pSrcB, q31_t * pDst, uint32_t blockSize);
+void ref_arm_add_q15(const q15_t * pSrcA, const q15_t * pSrcB, q15_t * pDst, uint32_t blockSize);
+void ref_arm_add_q7(const q7_t * pSrcA, const q7_t * pSrcB, q7_t * pDst, uint32_t blockSize);
+void ref_arm_mult_f32(const float32_t * pSrcA, const float32_t * pSrcB, float32_t * pDst, uint32_t blockSize);
+void ref_arm_mult_q31(const q31_t * pSrcA, const q31_t * pSrcB, q31_t * pDst, uint32_t blockSize);
+void ref_arm_mult_q15(const q15_t * pSrcA, const q15_t * pSrcB, q15_t * pDst, uint32_t blockSize);
+void ref_arm_mult_q7(const q7_t * pSrcA, const q7_t * pSrcB, q7_t * pDst, uint32_t blockSize);
+void ref_arm_abs_f32(const float32_t * pSrc, float32_t * pDst, uint32_t blockSize);
+void ref_arm_abs_q31(const q31_t * pSrc, q31_t * pDst, uint32_t blockSize);
+void ref_arm_abs_q15(const q15_t * pSrc, q15_t * pDst, uint32_t blockSize);
+void ref_arm_abs_q7(const q7_t * pSrc, q7_t * pDst, uint32_t blockSize);
+void ref_arm_scale_f32(const float32_t * pSrc, float32_t scale, float32_t * pDst, uint32_t blockSize);
+void ref_arm_scale_q31(const q31_t * pSrc, q31_t scaleFract, int8_t shift, q31_t * pDst, uint32_t blockSize);
+void ref_arm_scale_q15(const q15_t * pSrc, q15_t scaleFract, int8_t shift, q15_t * pDst, uint32_t blockSize);
+void ref_arm_scale_q7(const q7_t * pSrc, q7_t scaleFract, int8_t shift, q7_t * pDst, uint32_t blockSize);
+void ref_arm_dot_prod_f32(const float32_t * pSrcA, const float32_t * pSrcB, uint32_t blockSize, float32_t * result);
+void ref_arm_dot_prod_q31(const q31_t * pSrcA, const q31_t * pSrcB, uint32_t blockSize, q63_t * result);
+void ref_arm_dot_prod_q15(const q15_t * pSrcA, const q15_t * pSrcB, uint32_t blockSize, q63_t * result);
+void ref_arm_dot_prod_q7(const q7_t * pSrcA, const q7_t * pSrcB, uint32_t blockSize, q31_t * result);
+
+#define N       1100
+#define MAX_LEN 70
+
+static q7_t a7[N], b7[N], r7[N], o7[N];
+static q15_t a15[N], b15[N], r15[N], o15[N];
+static q31_t a31[N], b31[N], r31[N], o31[N];
+static float32_t af[N], bf[N], rf[N], of[N];
+static int fails = 0;
+
+static uint64_t rngState = 88172645463325252ull;
+
+static uint32_t rnd(void)
+{
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 7;
+  rngState ^= rngState << 17;
+  return (uint32_t)rngState;
+}
+
+/* mode 0: random, 1: saturation extremes, 2: most negative values (-128 * -128...) */
+static void fill(int mode)
+{
+  static const int32_t extremes[] = { INT32_MIN, INT32_MAX, 0, -1, 1 };
+  int i;
+
+  for (i = 0; i < N; i++)
+  {
+    uint32_t x = rnd(), y = rnd();
+
+    if (mode == 1)
+    {
+      if (x % 3 == 0) x = (uint32_t)extremes[y % 5];
+      if (y % 3 == 0) y = (uint32_t)extremes[x % 5];
+    }
+    else if (mode == 2)
+    {
+      x = (x & 0x01010101u) | 0x80808080u;
+      y = 0x80808080u;
+    }
+    a7[i] = (q7_t)x;   b7[i] = (q7_t)y;
+    a15[i] = (q15_t)x; b15[i] = (q15_t)y;
+    a31[i] = (q31_t)x; b31[i] = (q31_t)y;
+    af[i] = (int32_t)x / 1e6f;
+    bf[i] = (int32_t)y / 1e6f;
+    if (x % 17 == 0) af[i] = -0.0f;
+  }
+}
+
+static void fail(const char * name, uint32_t n)
+{
+  if (fails++ < 20)
+    printf("%s differs from the reference for blockSize %u\n", name, (unsigned)n);
+}
+
+#define CHECK_BLOCK(name, out, ref, n) \
+  if (memcmp(out, ref, (n) * sizeof(out[0])) != 0) fail(name, n)
+
+#define CHECK_BINARY(fn, a, b, out, ref, off, n) \
+  ref_##fn(a + off, b, ref, n); \
+  fn(a + off, b, out, n); \
+  CHECK_BLOCK(#fn, out, ref, n)
+
+#define CHECK_UNARY(fn, a, out, ref, off, n) \
+  ref_##fn(a + off, ref, n); \
+  fn(a + off, out, n); \
+  CHECK_BLOCK(#fn, out, ref, n)
+
+static void checkFixedPoint(uint32_t off, uint32_t n)
+{
+  int shift;
+
+  CHECK_BINARY(arm_add_q7, a7, b7, o7, r7, off, n);
+  CHECK_BINARY(arm_add_q15, a15, b15, o15, r15, off, n);
+  CHECK_BINARY(arm_add_q31, a31, b31, o31, r31, off, n);
+  CHECK_BINARY(arm_mult_q7, a7, b7, o7, r7, off, n);
+  CHECK_BINARY(arm_mult_q15, a15, b15, o15, r15, off, n);
+  CHECK_BINARY(arm_mult_q31, a31, b31, o31, r31, off, n);
+  CHECK_UNARY(arm_abs_q7, a7, o7, r7, off, n);
+  CHECK_UNARY(arm_abs_q15, a15, o15, r15, off, n);
+  CHECK_UNARY(arm_abs_q31, a31, o31, r31, off, n);
+
+  for (shift = -7; shift <= 7; shift++)
+  {
+    ref_arm_scale_q7(a7 + off, b7[shift + 7], (int8_t)shift, r7, n);
+    arm_scale_q7(a7 + off, b7[shift + 7], (int8_t)shift, o7, n);
+    CHECK_BLOCK("arm_scale_q7", o7, r7, n);
+  }
+  for (shift = -15; shift <= 15; shift++)
+  {
+    ref_arm_scale_q15(a15 + off, b15[shift + 15], (int8_t)shift, r15, n);
+    arm_scale_q15(a15 + off, b15[shift + 15], (int8_t)shift, o15, n);
+    CHECK_BLOCK("arm_scale_q15", o15, r15, n);
+  }
+  for (shift = -31; shift <= 30; shift++)
+  {
+    ref_arm_scale_q31(a31 + off, b31[shift + 31], (int8_t)shift, r31, n);
+    arm_scale_q31(a31 + off, b31[shift + 31], (int8_t)shift, o31, n);
+    CHECK_BLOCK("arm_scale_q31", o31, r31, n);
+  }
+
+  {
+    q31_t ref7, out7;
+    q63_t ref, out;
+
+    ref_arm_dot_prod_q7(a7 + off, b7, n, &ref7);
+    arm_dot_prod_q7(a7 + off, b7, n, &out7);
+    if (ref7 != out7) fail("arm_dot_prod_q7", n);
+    ref_arm_dot_prod_q15(a15 + off, b15, n, &ref);
+    arm_dot_prod_q15(a15 + off, b15, n, &out);
+    if (ref != out) fail("arm_dot_prod_q15", n);
+    ref_arm_dot_prod_q31(a31 + off, b31, n, &ref);
+    arm_dot_prod_q31(a31 + off, b31, n, &out);
+    if (ref != out) fail("arm_dot_prod_q31", n);
+  }
+}
+
+static void checkFloat(uint32_t off, uint32_t n)
+{
+  float32_t ref, out;
+  double magnitude = 0;
+  uint32_t i;
+
+  CHECK_BINARY(arm_add_f32, af, bf, of, rf, off, n);
+  CHECK_BINARY(arm_mult_f32, af, bf, of, rf, off, n);
+  CHECK_UNARY(arm_abs_f32, af, of, rf, off, n);
+  ref_arm_scale_f32(af + off, bf[3], rf, n);
+  arm_scale_f32(af + off, bf[3], of, n);
+  CHECK_BLOCK("arm_scale_f32", of, rf, n);
+
+  ref_arm_dot_prod_f32(af + off, bf, n, &ref);
+  arm_dot_prod_f32(af + off, bf, n, &out);
+  for (i = 0; i < n; i++)
+    magnitude += fabs((double)af[off + i] * bf[i]);
+  if (fabs((double)ref - out) > 1e-6 * magnitude + 1e-30)
+    fail("arm_dot_prod_f32", n);
+}
+
+static void checkAll(void)
+{
+  int mode, rep;
+  uint32_t n;
+
+  for (mode = 0; mode < 3; mode++)
+  {
+    for (rep = 0; rep < 10; rep++)
+    {
+      fill(mode);
+      for (n = 0; n <= MAX_LEN; n++)
+      {
+        uint32_t off = rnd() % 8;
+
+        checkFixedPoint(off, n);
+        checkFloat(off, n);
+      }
+    }
+  }
+
+  /* q15 dot product worst case: -32768 * -32768 accumulated over a long block */
+  {
+    q63_t ref, out;
+    int i;
+
+    for (i = 0; i < N; i++)
+      a15[i] = b15[i] = -32768;
+    ref_arm_dot_prod_q15(a15, b15, 1024, &ref);
+    arm_dot_prod_q15(a15, b15, 1024, &out);
+    if (ref != out) fail("arm_dot_prod_q15 (-32768)", 1024);
+  }
+}
+
+int main(void)
+{
+#if defined(ARM_MATH_X86_AVX2) && defined(__GNUC__)
+  if (!__builtin_cpu_supports("avx2"))
+  {
+    printf("skipped: no AVX2\n");
+    return 77;
+  }
+#endif
+
+#if defined(ARM_MATH_X86_DISPATCH)
+  {
+    int isa;
+
+    /* every instruction set the processor supports */
+    for (isa = ARM_X86_ISA_SSE2; isa <= (int)arm_dispatch_x86_detect(); isa++)
+    {
+      arm_dispatch_x86_select((arm_x86_isa)isa);
+      checkAll();
+    }
+  }
+#else
+  checkAll();
+#endif
+
+  if (fails != 0)
+  {
+    printf("%d check(s) failed\n", fails);
+    return 1;
+  }
+  printf("ok\n");
+  return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * x86 dispatch layer (ARM_MATH_X86_DISPATCH): select/current/name, refusal of
+ * an instruction set the processor lacks, and dispatched calls from several
+ * threads while the binding changes (the results stay exact).
+ */
+
+#include "arm_dispatch_x86.h"
+#include <pthread.h>
+#include <stdio.h>
+
+#define N 1037
+
+static q15_t a15[N], b15[N];
+static q63_t expected;
+static volatile int stop = 0;
+static int fails = 0;
+
+static void fail(const char * what)
+{
+  fails++;
+  printf("%s\n", what);
+}
+
+static void * caller(void * arg)
+{
+  int * wrong = (int *)arg;
+
+  while (!stop)
+  {
+    q63_t result;
+
+    arm_dot_prod_q15(a15, b15, N, &result);
+    if (result != expected)
+      (*wrong)++;
+  }
+  return NULL;
+}
+
+int main(void)
+{
+  arm_x86_isa best = arm_dispatch_x86_detect();
+  pthread_t threads[3];
+  int wrong[3] = { 0, 0, 0 };
+  int isa, i;
+
+  for (i = 0; i < N; i++)
+  {
+    a15[i] = (q15_t)(i * 7919);
+    b15[i] = (q15_t)(i * 104729 + 3);
+  }
+
+  /* the first call binds the best instruction set */
+  arm_dot_prod_q15(a15, b15, N, &expected);
+  if (arm_dispatch_x86_current() != best)
+    fail("first call did not bind the detected instruction set");
+
+  for (isa = ARM_X86_ISA_SSE2; isa < ARM_X86_ISA_COUNT; isa++)
+  {
+    arm_status status = arm_dispatch_x86_select((arm_x86_isa)isa);
+    q63_t result;
+
+    if (isa <= (int)best)
+    {
+      if (status != ARM_MATH_SUCCESS || arm_dispatch_x86_current() != (arm_x86_isa)isa)
+        fail("supported instruction set not selected");
+      arm_dot_prod_q15(a15, b15, N, &result);
+      if (result != expected)
+        fail("arm_dot_prod_q15 result depends on the instruction set");
+    }
+    else if (status != ARM_MATH_ARGUMENT_ERROR || arm_dispatch_x86_current() != best)
+      fail("unsupported instruction set not refused");
+    if (arm_dispatch_x86_name((arm_x86_isa)isa) == NULL)
+      fail("no name");
+  }
+
+  /* calls from other threads while this one keeps switching */
+  for (i = 0; i < 3; i++)
+    pthread_create(&threads[i], NULL, caller, &wrong[i]);
+  for (i = 0; i < 20000; i++)
+    arm_dispatch_x86_select((arm_x86_isa)(i % (best + 1)));
+  stop = 1;
+  for (i = 0; i < 3; i++)
+  {
+    pthread_join(threads[i], NULL);
+    if (wrong[i] != 0)
+      fail("wrong result during a concurrent select");
+  }
+
+  if (fails != 0)
+  {
+    printf("%d check(s) failed\n", fails);
+    return 1;
+  }
+  printf("ok (%s)\n", arm_dispatch_x86_name(best));
+  return 0;
+}
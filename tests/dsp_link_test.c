@@ -0,0 +1,13 @@
+/*
+ * Linked with the whole cmsisdsp_<variant> library (every object, not only
+ * the ones a program pulls in), so a function that calls an undefined symbol
+ * fails the build here instead of in the first program that calls it.
+ */
+
+#include <stdio.h>
+
+int main(void)
+{
+  printf("ok\n");
+  return 0;
+}
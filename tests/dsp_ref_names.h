@@ -0,0 +1,31 @@
+/*
+ * Forced include (-include) of the reference build of the BasicMath functions
+ * (plain C, no ARM_MATH_LOOPUNROLL or x86 intrinsics): the functions are
+ * renamed ref_arm_..., so that they link next to a cmsisdsp_<variant> library.
+ */
+
+#ifndef DSP_REF_NAMES_H
+#define DSP_REF_NAMES_H
+
+#define arm_add_f32       ref_arm_add_f32
+#define arm_add_q31       ref_arm_add_q31
+#define arm_add_q15       ref_arm_add_q15
+#define arm_add_q7        ref_arm_add_q7
+#define arm_mult_f32      ref_arm_mult_f32
+#define arm_mult_q31      ref_arm_mult_q31
+#define arm_mult_q15      ref_arm_mult_q15
+#define arm_mult_q7       ref_arm_mult_q7
+#define arm_abs_f32       ref_arm_abs_f32
+#define arm_abs_q31       ref_arm_abs_q31
+#define arm_abs_q15       ref_arm_abs_q15
+#define arm_abs_q7        ref_arm_abs_q7
+#define arm_scale_f32     ref_arm_scale_f32
+#define arm_scale_q31     ref_arm_scale_q31
+#define arm_scale_q15     ref_arm_scale_q15
+#define arm_scale_q7      ref_arm_scale_q7
+#define arm_dot_prod_f32  ref_arm_dot_prod_f32
+#define arm_dot_prod_q31  ref_arm_dot_prod_q31
+#define arm_dot_prod_q15  ref_arm_dot_prod_q15
+#define arm_dot_prod_q7   ref_arm_dot_prod_q7
+
+#endif /* DSP_REF_NAMES_H */
@@ -0,0 +1,370 @@
+//mcu::Serial: scatter-gather and reserve/commit tx, pipelined mode, SLIP/COBS
+//round trips, crc framing on a corrupting wire, the PC ports (loopback,
+//socketpair, pty) and FdPort write error handling. mcu::SerialTranseiver:
+//round trips through an in memory wire and a socketpair.
+#include "Check.hpp"
+#include "../Comm/Serial.hpp"
+#include "../Comm/StreamSocket.hpp"
+#include "../Comm/PC/SerialImp.hpp"
+#include "../Timer/PC/TimerImp.hpp"
+#include <cerrno>
+#include <deque>
+#include <random>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+
+namespace
+{
+
+//tx only port: the bytes written are collected in txOut
+std::vector<uint8_t> txOut;
+uint8_t noRxAvailable() { return 0; }
+uint8_t noRxRead() { return 0; }
+bool alwaysTxReady() { return true; }
+void collectTxWrite(uint8_t data) { txOut.push_back(data); }
+uint32_t noRxCount() { return 0; }
+void collectTxWriteBlock(const uint8_t* buff,uint32_t len) { txOut.insert(txOut.end(),buff,buff+len); }
+
+void checkScatterGatherAndReserve()
+{
+    mcu::Serial<64,20,Tim64_us,0,noRxAvailable,noRxRead,alwaysTxReady,collectTxWrite> serial;
+    serial.txInit();
+    const auto drain = [&]{ for( int i=0 ; i<1000 ; i++ ) serial.txTask(); };
+    uint8_t header[2]{1,2}, payload[3]{3,4,5}, crc[1]{6};
+    for( int round=0 ; round<7 ; round++ )
+    {
+        txOut.clear();
+        MCU_CHECK(serial.txFrameAppend({std::span<const uint8_t>(header),std::span<const uint8_t>(payload),std::span<const uint8_t>(crc)}));
+        drain();
+        MCU_CHECK(txOut == std::vector<uint8_t>({1,2,3,4,5,6}));
+        txOut.clear();
+        auto slot = serial.txFrameReserve(8);
+        if( !MCU_CHECK(slot) )
+            return;
+        //a reserved frame blocks appends until it is committed
+        MCU_CHECK(!serial.txFrameAppend(header,2));
+        for( int i=0 ; i<5 ; i++ )
+            (*slot)[i] = uint8_t(10+i);
+        MCU_CHECK(serial.txFrameCommit(5));
+        drain();
+        MCU_CHECK(txOut == std::vector<uint8_t>({10,11,12,13,14}));
+        slot = serial.txFrameReserve(3);
+        serial.txFrameAbort();
+    }
+}
+
+void checkPipelined()
+{
+    txOut.clear();
+    mcu::Serial<64,64,Tim64_us,1000,noRxAvailable,noRxRead,alwaysTxReady,collectTxWrite,mcu::SerialTxMode::pipelined,200> serial;
+    serial.txInit();
+    uint8_t payload[3]{3,4,5};
+    for( int i=0 ; i<10 ; i++ )
+        MCU_CHECK(serial.txFrameAppend(payload,3));
+    auto t0 = sysTick_us();
+    while( serial.txFramesPending() && sysTick_us()-t0 < 1000000 )
+        serial.txTask();
+    MCU_CHECK(txOut.size() == 30);
+    //9 inter-frame gaps of 200us
+    MCU_CHECK(sysTick_us()-t0 >= 9*200);
+}
+
+//in memory wire, optionally flipping bits
+std::deque<uint8_t> wire;
+bool corruptWire = false;
+std::mt19937 wireRng(1);
+uint16_t wireRxAvailable() { return wire.size() > 0; }
+uint8_t wireRxRead() { auto data = wire.front(); wire.pop_front(); return data; }
+void wireTxWrite(uint8_t data)
+{
+    if( corruptWire && wireRng()%50 == 0 )
+        data ^= 0x10;
+    wire.push_back(data);
+}
+
+template<typename t_Framing>
+void checkRoundTrip()
+{
+    mcu::Serial<600,600,Tim64_us,0,wireRxAvailable,wireRxRead,alwaysTxReady,wireTxWrite,mcu::SerialTxMode::serial,0,t_Framing> serial;
+    serial.txInit();
+    serial.rxInit();
+    std::mt19937 rng(1);
+    for( int it=0 ; it<300 ; it++ )
+    {
+        //biased to the bytes the framings escape
+        std::vector<uint8_t> frame(rng()%520+1);
+        for( auto& b : frame )
+            b = (rng()%3 == 0) ? 0 : (rng()%4 == 0 ? 0xC0 : (rng()%5 == 0 ? 0xDB : uint8_t(rng())));
+        if( it%7 == 0 )
+            for( auto& b : frame )
+                b = uint8_t(1+rng()%250);
+        MCU_CHECK(serial.txFrameAppend(frame.data(),frame.size()));
+        for( int i=0 ; i<5000 ; i++ )
+        {
+            serial.txTask();
+            serial.rxTask();
+        }
+        if( !MCU_CHECK(serial.rxFramesAvailable() == 1) || !MCU_CHECK(serial.rxFrameLength() == frame.size()) )
+            return;
+        bool same = true;
+        for( size_t i=0 ; i<frame.size() ; i++ )
+            same &= serial.rxFramePeekAt(i) == frame[i];
+        MCU_CHECK(same);
+        serial.rxFrameDiscard();
+    }
+}
+
+//with a crc the corrupted frames are dropped, the delivered ones are intact
+template<typename t_Framing,typename t_Crc>
+void checkCrcFraming()
+{
+    wire.clear();
+    mcu::Serial<600,600,Tim64_us,100,wireRxAvailable,wireRxRead,alwaysTxReady,wireTxWrite,mcu::SerialTxMode::serial,100,t_Framing,t_Crc> serial;
+    serial.txInit();
+    serial.rxInit();
+    for( int i=0 ; i<50 ; i++ )
+        serial.rxTask();
+    std::mt19937 rng(3);
+    int good = 0, dropped = 0;
+    for( int it=0 ; it<200 ; it++ )
+    {
+        std::vector<uint8_t> frame(rng()%500+1);
+        for( auto& b : frame )
+            b = uint8_t(rng());
+        corruptWire = t_Crc::size && it%3 == 0;
+        if( it%2 )
+            MCU_CHECK(serial.txFrameAppend(frame.data(),frame.size()));
+        else
+        {
+            auto slot = serial.txFrameReserve(frame.size()+10);
+            if( !MCU_CHECK(slot) || !MCU_CHECK(slot->size() == frame.size()+10) )
+                return;
+            for( size_t i=0 ; i<frame.size() ; i++ )
+                (*slot)[i] = frame[i];
+            MCU_CHECK(serial.txFrameCommit(frame.size()));
+        }
+        auto t0 = sysTick_us();
+        while( sysTick_us()-t0 < 3000 )
+        {
+            serial.txTask();
+            serial.rxTask();
+        }
+        if( serial.rxFramesAvailable() == 0 )
+        {
+            dropped++;
+            continue;
+        }
+        MCU_CHECK(serial.rxFramesAvailable() == 1);
+        if( !MCU_CHECK(serial.rxFrameLength() == frame.size()) )
+            return;
+        bool same = true;
+        for( size_t i=0 ; i<frame.size() ; i++ )
+            same &= serial.rxFramePeekAt(i) == frame[i];
+        MCU_CHECK(same);
+        serial.rxFrameDiscard();
+        good++;
+    }
+    corruptWire = false;
+    //the clean frames (2 out of 3) must all get through
+    MCU_CHECK(good >= 200*2/3);
+    if( t_Crc::size == 0 )
+        MCU_CHECK(dropped == 0);
+}
+
+//delimited framing: a pty can delay part of a frame longer than any eof timeout
+template<typename t_A,typename t_B>
+void checkPorts()
+{
+    mcu::Serial<600,600,Tim64_us,500,t_A::template rxAvailable<uint16_t>,t_A::rxRead,t_A::txReady,t_A::txWrite,
+                mcu::SerialTxMode::serial,500,mcu::CobsFraming,mcu::Crc16Ccitt> a;
+    mcu::Serial<600,600,Tim64_us,500,t_B::template rxAvailable<uint16_t>,t_B::rxRead,t_B::txReady,t_B::txWrite,
+                mcu::SerialTxMode::serial,500,mcu::CobsFraming,mcu::Crc16Ccitt> b;
+    a.txInit();
+    b.rxInit();
+    std::vector<uint8_t> frame(100);
+    for( size_t i=0 ; i<frame.size() ; i++ )
+        frame[i] = uint8_t(i*7);
+    for( int it=0 ; it<20 ; it++ )
+    {
+        MCU_CHECK(a.txFrameAppend(frame.data(),frame.size()));
+        auto t0 = sysTick_us();
+        while( b.rxFramesAvailable() == 0 && sysTick_us()-t0 < 1000000 )
+        {
+            a.txTask();
+            b.rxTask();
+        }
+        if( !MCU_CHECK(b.rxFramesAvailable() == 1) || !MCU_CHECK(b.rxFrameLength() == 100) )
+            return;
+        bool same = true;
+        for( int i=0 ; i<100 ; i++ )
+            same &= b.rxFramePeekAt(i) == frame[i];
+        MCU_CHECK(same);
+        b.rxFrameDiscard();
+    }
+}
+
+//clear() also resets the loss, a lossy test does not leak into the next one
+void checkLoopbackClear()
+{
+    using P = mcu::LoopbackPort<40,1000000>;
+    P::setLossPpm(1000000);
+    P::txWrite(0x5A);
+    P::clear();
+    P::txWrite(0xA5);
+    auto t0 = sysTick_us();
+    while( P::rxAvailable() == 0 && sysTick_us()-t0 < 1000 )
+        ;
+    MCU_CHECK(P::rxAvailable() == 1);
+    MCU_CHECK(P::rxRead() == 0xA5);
+}
+
+void checkWriteAll()
+{
+    using P0 = mcu::FdPort<30>;
+    using P1 = mcu::FdPort<31>;
+    int sv[2];
+    if( !MCU_CHECK(socketpair(AF_UNIX,SOCK_STREAM,0,sv) == 0) )
+        return;
+    P0::attach(sv[0]);
+    P1::attach(sv[1]);
+    //a block larger than the socket buffer: waits for room (poll) and completes
+    std::vector<uint8_t> big(1<<20,0x5A);
+    size_t got = 0;
+    std::thread reader([&]{ while( got < big.size() ) { if( P1::rxAvailable() ) { P1::rxRead(); got++; } } });
+    MCU_CHECK(P0::writeAll(big.data(),uint32_t(big.size())));
+    reader.join();
+    MCU_CHECK(got == big.size());
+    //peer closed: fails with EPIPE instead of spinning or raising SIGPIPE, a
+    //byte write drops the byte instead of keeping txReady() false forever
+    P1::close();
+    P0::txWrite(0x5A);
+    MCU_CHECK(P0::txReady());
+    MCU_CHECK(P0::txError() == EPIPE);
+    MCU_CHECK(!P0::writeAll(big.data(),1000));
+    MCU_CHECK(P0::txError() == EPIPE);
+    //closed descriptor
+    P0::close();
+    MCU_CHECK(!P0::writeAll(big.data(),10));
+    MCU_CHECK(P0::txError() == EBADF);
+    P0::txWrite(0x5A);
+    MCU_CHECK(P0::txReady());
+}
+
+//block wire of the transceivers: the blocks written are received in order
+std::deque<uint8_t> blockWire;
+uint32_t blockRxAvailable() { return uint32_t(blockWire.size()); }
+uint8_t blockRxRead() { auto data = blockWire.front(); blockWire.pop_front(); return data; }
+void blockTxWrite(const uint8_t* buff,uint32_t len) { blockWire.insert(blockWire.end(),buff,buff+len); }
+
+//each frame is sent in two parts (tx_send + tx_send_then_eof) by tx, and
+//received by rx (the same transceiver on a wire looped back)
+template<typename t_Tx,typename t_Rx>
+void checkTranseiver(t_Tx& tx,t_Rx& rx)
+{
+    //the receiver first waits for a quiet bus (TimeoutFraming)
+    auto t0 = sysTick_us();
+    while( sysTick_us()-t0 < 1000 )
+        rx.rx_task();
+    std::mt19937 rng(4);
+    for( int it=0 ; it<50 ; it++ )
+    {
+        std::vector<uint8_t> frame(rng()%280+1);
+        for( auto& b : frame )
+            b = (rng()%4 == 0) ? 0 : uint8_t(rng());
+        size_t half = frame.size()/2;
+        MCU_CHECK(tx.tx_send(frame.data(),uint32_t(half)));
+        MCU_CHECK(tx.tx_send_then_eof(frame.data()+half,uint32_t(frame.size()-half)));
+        t0 = sysTick_us();
+        while( !rx.rx_frame_available() && sysTick_us()-t0 < 1000000 )
+        {
+            tx.tx_task();
+            rx.rx_task();
+        }
+        if( !MCU_CHECK(rx.rx_frame_available()) || !MCU_CHECK(rx.rx_frame_length() == frame.size()) )
+            return;
+        auto data = rx.rx_frame_data();
+        MCU_CHECK(std::equal(data.begin(),data.end(),frame.begin()));
+        rx.rx_frame_discard();
+    }
+}
+
+template<typename t_Framing>
+void checkTranseiverWire()
+{
+    mcu::SerialTranseiver<600,600,Tim64_us,200,blockRxAvailable,blockRxRead,alwaysTxReady,blockTxWrite,t_Framing> serial;
+    checkTranseiver(serial,serial);
+}
+
+void checkTranseiverPorts()
+{
+    using P0 = mcu::FdPort<24>;
+    using P1 = mcu::FdPort<25>;
+    if( !MCU_CHECK((mcu::connectSocketPair<24,25>())) )
+        return;
+    mcu::SerialTranseiver<600,600,Tim64_us,200,P0::rxAvailable,P0::rxRead,P0::txReady,P0::txWrite,mcu::SlipFraming> a;
+    mcu::SerialTranseiver<600,600,Tim64_us,200,P1::rxAvailable,P1::rxRead,P1::txReady,P1::txWrite,mcu::SlipFraming> b;
+    checkTranseiver(a,b);
+}
+
+//an overflow drops the whole frame: nothing of it reaches t_tx_write, not
+//even the parts sent after the overflow
+template<typename t_Framing>
+void checkTranseiverOverflow()
+{
+    mcu::SerialTranseiver<64,16,Tim64_us,0,noRxCount,noRxRead,alwaysTxReady,collectTxWriteBlock,t_Framing> serial;
+    const auto drain = [&]{ for( int i=0 ; i<100 ; i++ ) serial.tx_task(); };
+    uint8_t data[20]{1,2,3,4,5,6,7,8,9,10,11,12};
+    txOut.clear();
+    MCU_CHECK(serial.tx_send(data,8));
+    MCU_CHECK(!serial.tx_send(data,12));
+    MCU_CHECK(!serial.tx_send(data,2));
+    drain();
+    MCU_CHECK(!serial.tx_send_then_eof(data,2));
+    drain();
+    MCU_CHECK(txOut.empty());
+    //the next frame is sent complete
+    MCU_CHECK(serial.tx_send(data,2));
+    MCU_CHECK(serial.tx_send_then_eof(data+2,3));
+    drain();
+    if constexpr ( t_Framing::delimited )
+        MCU_CHECK(txOut.size() > 5);
+    else
+        MCU_CHECK(txOut == std::vector<uint8_t>({1,2,3,4,5}));
+    //an overflow in tx_send_then_eof ends the frame, the next one is sent
+    txOut.clear();
+    MCU_CHECK(!serial.tx_send_then_eof(data,20));
+    drain();
+    MCU_CHECK(txOut.empty());
+    MCU_CHECK(serial.tx_send_then_eof(data,1));
+    drain();
+    MCU_CHECK(!txOut.empty());
+}
+
+}//namespace
+
+int main()
+{
+    checkScatterGatherAndReserve();
+    checkPipelined();
+    checkRoundTrip<mcu::SlipFraming>();
+    checkRoundTrip<mcu::CobsFraming>();
+    checkCrcFraming<mcu::TimeoutFraming,mcu::Crc32>();
+    checkCrcFraming<mcu::CobsFraming,mcu::Crc16Ccitt>();
+    checkCrcFraming<mcu::SlipFraming,mcu::Crc8>();
+    checkCrcFraming<mcu::SlipFraming,mcu::NoCrc>();
+    checkPorts<mcu::LoopbackPort<0,1000000,1>,mcu::LoopbackPort<1,1000000,0>>();
+    MCU_CHECK((mcu::connectSocketPair<20,21>()));
+    checkPorts<mcu::FdPort<20>,mcu::FdPort<21>>();
+    //no pty in some sandboxes: only tested when one can be opened
+    if( mcu::FdPort<10>::openPty() && MCU_CHECK(mcu::FdPort<11>::open(mcu::FdPort<10>::slaveName())) )
+        checkPorts<mcu::FdPort<10>,mcu::FdPort<11>>();
+    checkLoopbackClear();
+    checkWriteAll();
+    checkTranseiverWire<mcu::TimeoutFraming>();
+    checkTranseiverWire<mcu::CobsFraming>();
+    checkTranseiverPorts();
+    checkTranseiverOverflow<mcu::TimeoutFraming>();
+    checkTranseiverOverflow<mcu::CobsFraming>();
+    return mcu_test::result();
+}
@@ -0,0 +1,161 @@
+//mcu::Layout / toBytes / fromBytes (fixed endian records) and mcu::Schema
+//(delta + varint encoded records, keyframes)
+#include "Check.hpp"
+#include "../Utils/Serializer.hpp"
+#include "../Utils/Schema.hpp"
+#include "../Container/FifoBuffer.hpp"
+#include <climits>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+struct Tele
+{
+    uint32_t time;
+    int16_t  temp;
+    float    v[3];
+    uint8_t  flags;
+};
+using TeleLayout = mcu::Layout<&Tele::time,&Tele::temp,&Tele::v,&Tele::flags>;
+
+enum class Code : uint16_t { a = 0x1234 };
+
+static_assert(TeleLayout::size == 19);
+static_assert(mcu::toBytes(uint32_t(0x11223344))[0] == 0x44);
+static_assert(mcu::toBytes<std::endian::big>(uint32_t(0x11223344))[0] == 0x11);
+static_assert(mcu::fromBytes<uint16_t,std::endian::big>({0x12,0x34}) == 0x1234);
+static_assert(mcu::toBytes<std::endian::big>(Code::a)[0] == 0x12);
+
+void checkLayout()
+{
+    Tele tele{0x01020304,-2,{1.5f,-2.f,3.25f},7};
+    auto big = TeleLayout::toBytes<std::endian::big>(tele);
+    MCU_CHECK(big[0] == 1 && big[3] == 4 && big[4] == 0xFF && big[5] == 0xFE);
+    Tele decoded{};
+    TeleLayout::decode<std::endian::big>(decoded,big.data());
+    MCU_CHECK(decoded.time == tele.time && decoded.temp == -2 && decoded.v[2] == 3.25f && decoded.flags == 7);
+    auto little = TeleLayout::toBytes(tele);
+    Tele decodedLittle{};
+    TeleLayout::decode(decodedLittle,little.data());
+    MCU_CHECK(little[0] == 4 && decodedLittle.v[1] == -2.f);
+    //straight into the (wrapping) free space of a fifo
+    mcu::FifoRaw<uint8_t,32> fifo;
+    uint8_t filler[25]{};
+    fifo.put(filler,25);
+    for( int i=0 ; i<25 ; i++ )
+        fifo.get();
+    MCU_CHECK(mcu::scatter(fifo.reserve(TeleLayout::size),little.data(),little.size()) == TeleLayout::size);
+    bool same = true;
+    for( size_t i=0 ; i<TeleLayout::size ; i++ )
+        same &= fifo.peekAt(i) == little[i];
+    MCU_CHECK(same);
+}
+
+struct Sample
+{
+    uint32_t time;
+    int16_t  temp;
+    uint16_t adc;
+    float    v;
+    bool     alarm;
+    bool     door;
+    uint8_t  state;
+    int32_t  pos;
+};
+using SampleSchema = mcu::Schema<mcu::VarintField<&Sample::time,true>,mcu::ZigzagField<&Sample::temp>,mcu::VarintField<&Sample::adc>,
+                                 mcu::RawField<&Sample::v>,mcu::BitField<&Sample::alarm>,mcu::BitField<&Sample::door>,
+                                 mcu::VarintField<&Sample::state>,mcu::ZigzagField<&Sample::pos,true>>;
+static_assert(SampleSchema::flagBytes == 1);
+
+struct Small
+{
+    uint8_t a;
+    int8_t  b;
+};
+using SmallSchema = mcu::Schema<mcu::VarintField<&Small::a>,mcu::ZigzagField<&Small::b>>;
+
+bool operator==(const Sample& l,const Sample& r)
+{
+    return l.time == r.time && l.temp == r.temp && l.adc == r.adc && l.v == r.v && l.alarm == r.alarm &&
+           l.door == r.door && l.state == r.state && l.pos == r.pos;
+}
+
+std::vector<Sample> makeSamples()
+{
+    std::vector<Sample> samples;
+    uint32_t time = 1000000;
+    int32_t pos = -5000;
+    for( int i=0 ; i<10000 ; i++ )
+    {
+        time += 1000+(i%7);
+        pos += (i%5)-2;
+        samples.push_back({time,int16_t(-300+i%50),uint16_t(2000+(i*37)%400),float(std::sin(i*0.01)),
+                           i%100 == 0,(i/500)%2 == 1,uint8_t(i%4),pos});
+    }
+    return samples;
+}
+
+void checkSchema()
+{
+    auto samples = makeSamples();
+    SampleSchema::Encoder encoder;
+    SampleSchema::Decoder decoder;
+    std::vector<uint8_t> buff(SampleSchema::maxSize);
+    size_t total = 0;
+    int bad = 0;
+    for( size_t i=0 ; i<samples.size() ; i++ )
+    {
+        size_t len = encoder.encode(samples[i],buff.data(),i%1000 == 0);
+        total += len;
+        Sample decoded{};
+        if( !decoder.decode(buff.data(),len,decoded) || !(decoded == samples[i]) )
+            bad++;
+    }
+    MCU_CHECK(bad == 0);
+    //slowly changing telemetry: about a third smaller than the raw record
+    MCU_CHECK(total < samples.size()*sizeof(Sample)*2/3);
+    //a delta record needs a keyframe first, a truncated record is rejected
+    SampleSchema::Decoder fresh;
+    Sample decoded{};
+    size_t len = encoder.encode(samples[5],buff.data());
+    MCU_CHECK(!fresh.decode(buff.data(),len,decoded));
+    len = encoder.encode(samples[6],buff.data(),true);
+    MCU_CHECK(fresh.decode(buff.data(),len,decoded) && decoded.time == samples[6].time);
+    MCU_CHECK(!fresh.decode(buff.data(),len-1,decoded));
+}
+
+void checkSchemaExtremes()
+{
+    Small small{255,-128};
+    SmallSchema::Encoder smallEncoder;
+    SmallSchema::Decoder smallDecoder;
+    uint8_t smallBuff[SmallSchema::maxSize];
+    size_t len = smallEncoder.encode(small,smallBuff);
+    Small smallDecoded{};
+    MCU_CHECK(smallDecoder.decode(smallBuff,len,smallDecoded) && smallDecoded.a == 255 && smallDecoded.b == -128);
+    Sample extreme{0xFFFFFFFF,-32768,65535,-1.f,true,true,255,INT32_MIN};
+    SampleSchema::Encoder encoder;
+    SampleSchema::Decoder decoder;
+    uint8_t buff[SampleSchema::maxSize];
+    len = encoder.encode(extreme,buff);
+    MCU_CHECK(len <= SampleSchema::maxSize);
+    Sample decoded{};
+    MCU_CHECK(decoder.decode(buff,len,decoded) && decoded == extreme);
+    //deltas that wrap around
+    extreme.time = 0;
+    extreme.pos = INT32_MAX;
+    len = encoder.encode(extreme,buff);
+    MCU_CHECK(decoder.decode(buff,len,decoded) && decoded == extreme);
+}
+
+}//namespace
+
+int main()
+{
+    checkLayout();
+    checkSchema();
+    checkSchemaExtremes();
+    return mcu_test::result();
+}
@@ -0,0 +1,66 @@
+//mcu::StreamSocket: an ordered byte stream over two lossy loopback uarts
+//(a window of 8 segments of 64 bytes), checked byte by byte
+#include "Check.hpp"
+#include "../Comm/StreamSocket.hpp"
+#include "../Comm/PC/SerialImp.hpp"
+#include "../Timer/PC/TimerImp.hpp"
+
+namespace
+{
+
+using L0 = mcu::LoopbackPort<0,1000000,1>;
+using L1 = mcu::LoopbackPort<1,1000000,0>;
+using S0 = mcu::Serial<1024,1024,Tim64_us,100,L0::rxAvailable,L0::rxRead,L0::txReady,L0::txWrite,mcu::SerialTxMode::serial,100,mcu::CobsFraming,mcu::Crc16Ccitt>;
+using S1 = mcu::Serial<1024,1024,Tim64_us,100,L1::rxAvailable,L1::rxRead,L1::txReady,L1::txWrite,mcu::SerialTxMode::serial,100,mcu::CobsFraming,mcu::Crc16Ccitt>;
+using K0 = mcu::StreamSocket<S0,Tim64_us,5000,512,512,8,64>;
+using K1 = mcu::StreamSocket<S1,Tim64_us,5000,512,512,8,64>;
+
+void checkStream(uint32_t lossPpm)
+{
+    L0::setLossPpm(lossPpm);
+    L1::setLossPpm(lossPpm);
+    S0 s0;
+    S1 s1;
+    K0 k0(s0);
+    K1 k1(s1);
+    s0.rxInit();
+    s0.txInit();
+    s1.rxInit();
+    s1.txInit();
+    const size_t total = 20000;
+    size_t written = 0, received = 0;
+    bool inOrder = true;
+    uint8_t buff[200];
+    auto t0 = sysTick_us();
+    while( received < total && sysTick_us()-t0 < 30000000 )
+    {
+        while( written < total && k0.txFreeSpace() )
+        {
+            uint8_t data = uint8_t(written*31+7);
+            if( !k0.write(&data,1) )
+                break;
+            written++;
+        }
+        s0.rxTask();
+        s1.rxTask();
+        k0.task();
+        k1.task();
+        s0.txTask();
+        s1.txTask();
+        auto len = k1.read(buff,sizeof(buff));
+        for( size_t i=0 ; i<len ; i++ )
+            inOrder &= buff[i] == uint8_t((received+i)*31+7);
+        received += len;
+    }
+    MCU_CHECK(received == total);
+    MCU_CHECK(inOrder);
+}
+
+}//namespace
+
+int main()
+{
+    checkStream(0);
+    checkStream(2000);
+    return mcu_test::result();
+}
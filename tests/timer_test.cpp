@@ -0,0 +1,186 @@
+//mcu::Timer conversions and Deadline, the lazy tsc calibration and
+//mcu::TimerWheel (every entry fires on its exact tick)
+#include "Check.hpp"
+#include "../Timer/PC/TimerImp.hpp"
+#include "../Timer/TimerWheel.hpp"
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+using Tim37_5us = mcu::Timer<uint32_t,3,80000,sysTick32_us>;
+using Tim32_ms  = mcu::Timer<uint32_t,1,1000,sysTick32_ms>;
+
+static_assert(Tim32_us::toTicks(10ms) == 10000);
+static_assert(Tim32_ms::toTicks(std::chrono::microseconds(2500)) == 3);
+static_assert(Tim32_ms::toTicks(std::chrono::microseconds(3000)) == 3);
+static_assert(Tim37_5us::toTicks(1ms) == 27);
+
+void checkToTicks()
+{
+    //no intermediate overflow, rounded up like the exact integer division
+    std::mt19937_64 rng(3);
+    int bad = 0;
+    for( uint32_t i=0 ; i<2000000 ; i++ )
+    {
+        uint32_t us = uint32_t(rng());
+        if( i < 1000 )
+            us = i;
+        else if( i < 2000 )
+            us = 0xFFFFFFFFu-(i-1000);
+        if( Tim32_ms::toTicks(std::chrono::duration<uint32_t,std::micro>(us)) != uint32_t((uint64_t(us)+999)/1000) )
+            bad++;
+        if( Tim37_5us::toTicks(std::chrono::duration<uint32_t,std::micro>(us)) != uint32_t((uint64_t(us)*2+74)/75) )
+            bad++;
+    }
+    for( uint64_t big : {uint64_t(1)<<40,(uint64_t(1)<<33)+12345} )
+        if( Tim32_ms::toTicks(std::chrono::duration<uint64_t,std::micro>(big)) != uint32_t((big+999)/1000) )
+            bad++;
+    MCU_CHECK(bad == 0);
+}
+
+uint8_t tick8_ms() { return uint8_t(sysTick_ms()); }
+uint32_t fakeMs = 0;
+auto fakeTick_ms() -> uint32_t { return fakeMs; }
+
+void checkDeadline()
+{
+    Tim32_us::Deadline deadline(3ms);
+    MCU_CHECK(!deadline.expired());
+    MCU_CHECK(deadline.remaining() <= 3000);
+    while( !deadline.expired() );
+    MCU_CHECK(deadline.remaining() == 0);
+    Tim32_us::Deadline none;
+    MCU_CHECK(none.expired());
+    //8 bit counter: 100 ticks still fit
+    using Tim8_ms = mcu::Timer<uint8_t,1,1000,tick8_ms>;
+    Tim8_ms::Deadline shortDeadline(100ms);
+    MCU_CHECK(!shortDeadline.expired());
+    MCU_CHECK(shortDeadline.remaining() <= 100);
+    //a period that is not a whole number of ticks does not expire early
+    using FakeMs = mcu::Timer<uint32_t,1,1000,fakeTick_ms>;
+    FakeMs::Deadline partial(std::chrono::microseconds(2500));
+    fakeMs += 2;
+    MCU_CHECK(!partial.expired());
+    fakeMs += 1;
+    MCU_CHECK(partial.expired());
+    partial.extend(std::chrono::microseconds(1));
+    MCU_CHECK(!partial.expired());
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+void checkTscCalibration()
+{
+    //calibrated (20ms busy wait) on the first use, not at static init
+    auto t0 = std::chrono::steady_clock::now();
+    auto first = tscTick_us();
+    auto t1 = std::chrono::steady_clock::now();
+    MCU_CHECK(t1-t0 >= 15ms);
+    std::this_thread::sleep_for(50ms);
+    auto elapsed = tscTick_us()-first;
+    MCU_CHECK(elapsed >= 45000 && elapsed < 1000000);
+    auto t2 = std::chrono::steady_clock::now();
+    tscTick_us();
+    MCU_CHECK(std::chrono::steady_clock::now()-t2 < 15ms);
+}
+#endif
+
+uint8_t fakeTicks8 = 0;
+auto fakeTick8() -> uint8_t { return fakeTicks8; }
+uint32_t fakeTicks32 = 0;
+auto fakeTick32() -> uint32_t { return fakeTicks32; }
+
+template<typename t_Wheel>
+struct WheelJob
+{
+    t_Wheel* wheel;
+    uint64_t expected;
+    uint64_t period;
+    int fired = 0;
+    int late = 0;
+};
+
+//random delays and periods, a third cancelled, advanced by random steps on
+//an 8 bit counter (wraps every 256 ticks)
+template<typename t_Wheel>
+void checkWheel()
+{
+    using Job = WheelJob<t_Wheel>;
+    t_Wheel wheel;
+    std::mt19937 rng(1);
+    std::vector<std::unique_ptr<typename t_Wheel::Entry>> entries;
+    std::vector<Job> jobs(2000);
+    for( size_t i=0 ; i<jobs.size() ; i++ )
+    {
+        entries.emplace_back(new typename t_Wheel::Entry([](void* arg)
+        {
+            auto job = static_cast<Job*>(arg);
+            if( job->wheel->ticks() != job->expected )
+                job->late++;
+            job->fired++;
+            job->expected += job->period;
+        },&jobs[i]));
+        uint64_t delay = 1+rng()%100000;
+        uint64_t period = (i%3 == 0) ? 1+rng()%5000 : 0;
+        jobs[i] = {&wheel,delay,period};
+        wheel.start(*entries[i],delay,period);
+    }
+    for( size_t i=1 ; i<jobs.size() ; i+=3 )
+        wheel.cancel(*entries[i]);
+    uint64_t now = 0;
+    while( now < 300000 )
+    {
+        uint32_t step = 1+rng()%200;
+        now += step;
+        fakeTicks8 = uint8_t(fakeTicks8+step);
+        wheel.task();
+    }
+    int late = 0, wrong = 0;
+    for( size_t i=0 ; i<jobs.size() ; i++ )
+    {
+        late += jobs[i].late;
+        if( i%3 == 1 )
+            wrong += jobs[i].fired != 0;
+        else if( jobs[i].period == 0 )
+            wrong += jobs[i].fired != (jobs[i].expected <= now ? 1 : 0);
+        else
+            wrong += jobs[i].expected <= now;   //a due expiry was missed
+    }
+    MCU_CHECK(late == 0);
+    MCU_CHECK(wrong == 0);
+}
+
+//one far timer and one big step: fires once, on its tick
+void checkWheelSparse()
+{
+    using Wheel = mcu::TimerWheel<uint32_t,1,1000000,fakeTick32>;
+    static Wheel wheel;
+    static uint64_t firedAt = 0;
+    Wheel::Entry entry([](void*){ firedAt = wheel.ticks(); });
+    wheel.start(entry,uint64_t(10000000));
+    fakeTicks32 += 20000000;
+    wheel.task();
+    MCU_CHECK(firedAt == 10000000);
+    MCU_CHECK(wheel.ticks() == 20000000);
+    MCU_CHECK(wheel.activeCount() == 0);
+}
+
+}//namespace
+
+int main()
+{
+    checkToTicks();
+    checkDeadline();
+#if defined(__x86_64__) || defined(__i386__)
+    checkTscCalibration();
+#endif
+    checkWheel<mcu::TimerWheel<uint8_t,1,1000,fakeTick8>>();
+    checkWheel<mcu::TimerWheel<uint8_t,1,1000,fakeTick8,2,3>>();
+    checkWheelSparse();
+    return mcu_test::result();
+}
@@ -0,0 +1,205 @@
+//zcd_t: process_block bit-equal to process_sample (events, half periods and
+//the whole state), the crossing fits and statistics, zcd_multi_t against one
+//zcd_t per channel and zcd_rt_t against the static zcd_t
+#include "Check.hpp"
+#include "../DSP/zcd_multi.h"
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+//the SIMD selection macros do not leak out of the header
+#if defined(ZCD_SIMD_SSE) || defined(ZCD_SIMD_NEON)
+#error "DSP/zcd.h leaks ZCD_SIMD_*"
+#endif
+
+namespace
+{
+
+std::vector<std::pair<uint32_t,uint32_t>> events;
+void recordEvent(uint32_t a,uint32_t b) { events.push_back({a,b}); }
+int crossings = 0;
+void countCrossing() { crossings++; }
+
+void checkBlockEqualsSample()
+{
+    using Zcd = zcd_t<200000.0f,0.01f>;
+    std::mt19937 rng(1);
+    std::normal_distribution<float> noise(0,0.02f);
+    std::vector<float> x(400000);
+    for( size_t i=0 ; i<x.size() ; i++ )
+        x[i] = float(std::sin(2*M_PI*50.03*i/200000.0))+noise(rng);
+    //signed zeros and denormal sized values on the way
+    x[1000] = 0;
+    x[1001] = -0.0f;
+    x[5000] = 1e-30f;
+    x[5001] = -1e-30f;
+    Zcd a, b;
+    a.install_zcd_metadata_callback(recordEvent);
+    a.install_zcd_callback(countCrossing);
+    for( auto s : x )
+        a.process_sample(s);
+    auto sampleEvents = events;
+    int sampleCrossings = crossings;
+    events.clear();
+    crossings = 0;
+    b.install_zcd_metadata_callback(recordEvent);
+    b.install_zcd_callback(countCrossing);
+    std::mt19937 blocks(2);
+    for( size_t i=0 ; i<x.size() ; )
+    {
+        size_t len = std::min<size_t>(blocks()%300,x.size()-i);
+        b.process_block(x.data()+i,len);
+        i += len;
+    }
+    MCU_CHECK(sampleEvents.size() > 150);
+    MCU_CHECK(events == sampleEvents);
+    MCU_CHECK(crossings == sampleCrossings);
+    MCU_CHECK(std::memcmp(&a,&b,sizeof(a)) == 0);
+}
+
+constexpr float fitFs = 4000.0f;
+
+//relative error of the period measured on each half period pair
+template<typename t_Zcd>
+double periodError(t_Zcd& zcd,double f0,double noiseRms,double dc)
+{
+    std::mt19937 rng(5);
+    std::normal_distribution<double> noise(0,noiseRms);
+    double phase = 0, maxErr = 0;
+    for( size_t i=0 ; i<fitFs*4 ; i++ )
+    {
+        phase += 2*M_PI*f0/fitFs;
+        zcd.process_sample(float(std::sin(phase)+dc+noise(rng)));
+        if( i > fitFs )
+        {
+            auto hp = zcd.get_half_period();
+            maxErr = std::max(maxErr,std::fabs((hp.first+hp.second)*f0-1.0));
+        }
+    }
+    return maxErr;
+}
+
+void checkFits()
+{
+    using Linear = zcd_t<fitFs,0.005f,zcd_fit::linear,32>;
+    using Cubic = zcd_t<fitFs,0.005f,zcd_fit::cubic,32>;
+    //80 samples per period: the cubic fit is two orders better than the linear one
+    Linear linear;
+    Cubic cubic;
+    double linearErr = periodError(linear,49.7,0,0);
+    double cubicErr = periodError(cubic,49.7,0,0);
+    MCU_CHECK(linearErr < 1e-5);
+    MCU_CHECK(cubicErr < 1e-6);
+    MCU_CHECK(cubicErr < linearErr/10);
+    //statistics and pll on a noisy offset signal
+    Cubic noisy;
+    noisy.enable_pll(0.2f,0.01f);
+    MCU_CHECK(periodError(noisy,50.0,1e-3,0.05) < 2e-3);
+    MCU_CHECK(std::fabs(noisy.frequency()-50.0f) < 1e-3f);
+    MCU_CHECK(std::fabs(noisy.pll_frequency()-50.0f) < 1e-3f);
+    MCU_CHECK(noisy.jitter() < 1e-4f);
+    MCU_CHECK(std::fabs(noisy.rocof()) < 0.05f);
+    //block processing is still bit-equal with the fit, statistics and pll
+    std::vector<float> x(100000);
+    std::mt19937 rng(1);
+    std::normal_distribution<float> noise(0,0.01f);
+    for( size_t i=0 ; i<x.size() ; i++ )
+        x[i] = float(std::sin(2*M_PI*50.1*i/fitFs))+noise(rng);
+    Cubic a, b;
+    a.enable_pll(0.2f,0.01f);
+    b.enable_pll(0.2f,0.01f);
+    for( auto s : x )
+        a.process_sample(s);
+    std::mt19937 blocks(7);
+    for( size_t i=0 ; i<x.size() ; )
+    {
+        size_t len = std::min<size_t>(blocks()%7 == 0 ? blocks()%4 : blocks()%300,x.size()-i);
+        b.process_block(x.data()+i,len);
+        i += len;
+    }
+    MCU_CHECK(std::memcmp(&a,&b,sizeof(a)) == 0);
+}
+
+void checkMulti()
+{
+    constexpr size_t channels = 12;
+    constexpr size_t frames = 100000;
+    std::mt19937 rng(1);
+    std::normal_distribution<float> noise(0,0.02f);
+    std::vector<float> interleaved(frames*channels);
+    std::vector<std::vector<float>> split(channels,std::vector<float>(frames));
+    for( size_t f=0 ; f<frames ; f++ )
+        for( size_t c=0 ; c<channels ; c++ )
+        {
+            float v = float(std::sin(2*M_PI*(49.9+0.02*c)*f/200000.0+c*2.1))+noise(rng);
+            interleaved[f*channels+c] = v;
+            split[c][f] = v;
+        }
+    std::vector<zcd_t<200000.0f,0.01f>> single(channels);
+    zcd_multi_t<200000.0f,0.01f,channels> multi;
+    uint64_t singleCrossings = 0, multiCrossings = 0;
+    bool same = true;
+    std::mt19937 blocks(3);
+    for( size_t f=0 ; f<frames ; )
+    {
+        size_t len = std::min<size_t>(blocks()%500,frames-f);
+        for( size_t c=0 ; c<channels ; c++ )
+        {
+            crossings = 0;
+            single[c].install_zcd_callback(countCrossing);
+            for( size_t i=0 ; i<len ; i++ )
+                single[c].process_sample(split[c][f+i]);
+            singleCrossings += crossings;
+        }
+        auto& result = multi.process_frames(interleaved.data()+f*channels,len);
+        for( size_t c=0 ; c<channels ; c++ )
+        {
+            multiCrossings += result.crossings[c];
+            auto a = single[c].get_half_period(), b = multi.get_half_period(c);
+            same &= std::memcmp(&a,&b,sizeof(a)) == 0;
+        }
+        f += len;
+    }
+    MCU_CHECK(singleCrossings > 500);
+    MCU_CHECK(multiCrossings == singleCrossings);
+    MCU_CHECK(same);
+}
+
+void checkRuntime()
+{
+    std::vector<float> y(400000);
+    for( size_t i=0 ; i<y.size() ; i++ )
+        y[i] = float(std::sin(2*M_PI*49.7*i/200000.0+0.3)+0.001*std::sin(i*1.7));
+    zcd_t<200000.0f,0.01f> fixed;
+    zcd_rt_t<> runtime(200000.0f,0.01f);
+    double maxDiff = 0;
+    for( auto v : y )
+    {
+        fixed.process_sample(v);
+        runtime.process_sample(v);
+        maxDiff = std::max(maxDiff,double(std::fabs(fixed.get_half_period().second-runtime.get_half_period().second)));
+    }
+    MCU_CHECK(maxDiff < 1e-8);
+    //switching the sampling rate at run time
+    MCU_CHECK(runtime.set_sampling(100000.0f,0.01f));
+    MCU_CHECK(!runtime.set_sampling(0,1));
+    std::vector<float> z(200000);
+    for( size_t i=0 ; i<z.size() ; i++ )
+        z[i] = float(std::sin(2*M_PI*60.0*i/100000.0+0.1));
+    runtime.process_block(z.data(),z.size());
+    auto hp = runtime.get_half_period();
+    MCU_CHECK(runtime.get_fs() == 100000.0f);
+    MCU_CHECK(std::fabs(1/(hp.first+hp.second)-60.0f) < 1e-3f);
+}
+
+}//namespace
+
+int main()
+{
+    checkBlockEqualsSample();
+    checkFits();
+    checkMulti();
+    checkRuntime();
+    return mcu_test::result();
+}